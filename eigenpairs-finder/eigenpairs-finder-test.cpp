@@ -4,6 +4,7 @@
 //#include <Eigen/Eigenvalues>
 
 #include "eigenpairs-finder.h"
+#include "krylov/krylov.h"
 
 void conjugation_test() {
     std::cout << "conjugation test";
@@ -38,6 +39,42 @@ void norm_test() {
     std::cout << norm(vector);
 }
 
+void householder_test() {
+    std::cout << "householder reflector test";
+    std::cout << '\n' << '\n';
+
+    Matrix<double> matrix;
+    std::ifstream file;
+    file.open("../matrix/matrix.txt");
+    file >> matrix;
+    file.close();
+
+    matrix = matrix[Slice(0, matrix.m())];
+    auto v = householder_vector(matrix[Slice(0, matrix.n()), 0]);
+    Matrix<double> reflector = identity<double>(matrix.n()) - 2.0 * v * conj(v);
+    std::cout << "matrix:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    // reflector zeroes first column below diagonal
+    Matrix<double> left = matrix;
+    apply_householder_left(left[Slice(0, left.n()), Slice(0, left.m())], v);
+    std::cout << "(I - 2vv*) * matrix:" << '\n';
+    std::cout << left;
+    std::cout << '\n' << '\n';
+    std::cout << "L2 norm of error matrix:" << '\n';
+    std::cout << m_norm(left - reflector * matrix);
+    std::cout << '\n' << '\n';
+
+    Matrix<double> right = matrix;
+    apply_householder_right(right[Slice(0, right.n()), Slice(0, right.m())], v);
+    std::cout << "matrix * (I - 2vv*):" << '\n';
+    std::cout << right;
+    std::cout << '\n' << '\n';
+    std::cout << "L2 norm of error matrix:" << '\n';
+    std::cout << m_norm(right - matrix * reflector);
+}
+
 void real_hessenberg_test() {
     std::cout << "real matrix hessenberg decomposition test";
     std::cout << '\n' <<'\n';
@@ -402,11 +439,430 @@ void real_schur_test() {
     std::cout << m_norm(copy - Q * matrix * conj(Q));
 }
 
+void eigenpairs_real_arithmetic_test() {
+    std::cout << "eigenpairs of real matrix in real arithmetic test";
+    std::cout << '\n' << '\n';
+
+    Matrix<double> matrix;
+    std::ifstream file;
+    file.open("../matrix/matrix2.txt");
+    file >> matrix;
+    file.close();
+
+    std::cout << "matrix:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    Matrix<std::complex<double>> complex_matrix = matrix;
+    auto eigenparis = eigenpairs(matrix);
+    for (int i = 0; i < eigenparis.size(); ++i) {
+        auto eigenvalue = eigenparis[i].first;
+        auto eigenvector = eigenparis[i].second;
+
+        std::cout << "eigenvector with eigenvalue " << eigenvalue << ":" << '\n';
+        std::cout << eigenvector;
+        std::cout << '\n' << '\n';
+
+        std::cout << "residual norm:" << '\n';
+        std::cout << norm(complex_matrix * eigenvector - eigenvalue * eigenvector);
+        if (i != eigenparis.size()-1) {
+            std::cout << '\n' << '\n';
+        }
+    }
+}
+
+void large_schur_test() {
+    std::cout << "Schur decomposition of large badly scaled matrix test";
+    std::cout << '\n' << '\n';
+
+    // elements range from 1e-4 to 1e4, size is large enough for aggressive early deflation
+    std::size_t n = 120;
+    auto matrix = Matrix<double>(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            matrix[i, j] = std::sin(double(i * n + j)) * std::pow(10.0, 8.0 * (double(i) - double(j)) / n);
+        }
+    }
+
+    Matrix<double> real_T = matrix;
+    Matrix<double> real_Q = hessenberg(real_T);
+    real_Q = real_Q * real_schur(real_T);
+
+    Matrix<std::complex<double>> complex_T = matrix;
+    Matrix<std::complex<double>> complex_Q = hessenberg(complex_T);
+    complex_Q = complex_Q * complex_schur(complex_T);
+
+    std::cout << "relative error of real Schur decomposition is small:" << '\n';
+    std::cout << (m_norm(matrix - real_Q * real_T * conj(real_Q)) / m_norm(matrix) < 1e-13) << '\n';
+    std::cout << "relative error of complex Schur decomposition is small:" << '\n';
+    std::cout << (m_norm(Matrix<std::complex<double>>(matrix) - complex_Q * complex_T * conj(complex_Q)) / m_norm(matrix) < 1e-13);
+}
+
+void blocked_hessenberg_test() {
+    std::cout << "blocked Hessenberg decomposition test";
+    std::cout << '\n' << '\n';
+
+    std::size_t n = 250;
+    auto matrix = Matrix<std::complex<double>>(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            matrix[i, j] = std::complex<double>(std::sin(double(i * i + 7 * j * j + i * j)), std::cos(double(3 * i * j + j)));
+        }
+    }
+
+    // the same reflectors are applied one by one and by panels of 16
+    std::size_t size = hessenberg_block_size();
+    set_hessenberg_block_size(1);
+    Matrix<std::complex<double>> H = matrix;
+    Matrix<std::complex<double>> Q = hessenberg(H);
+    set_hessenberg_block_size(16);
+    Matrix<std::complex<double>> blocked_H = matrix;
+    Matrix<std::complex<double>> blocked_Q = hessenberg(blocked_H);
+    set_hessenberg_block_size(size);
+
+    Matrix<std::complex<double>> error = matrix - blocked_Q * blocked_H * conj(blocked_Q);
+    Matrix<std::complex<double>> difference = H - blocked_H;
+    std::cout << "relative error of blocked decomposition is small:" << '\n';
+    std::cout << (m_norm(error) / m_norm(matrix) < 1e-13) << '\n';
+    // the reduction is backward stable only, ulp-sized perturbations of the input already move H by ~1e-12
+    std::cout << "blocked and unblocked Hessenberg matrices are equal up to rounding:" << '\n';
+    std::cout << (m_norm(difference) / m_norm(matrix) < 1e-10);
+}
+
+void hermitian_eigenpairs_test() {
+    std::cout << "eigenpairs of hermitian matrix test";
+    std::cout << '\n' << '\n';
+
+    Matrix<double> matrix;
+    std::ifstream file;
+    file.open("../matrix/matrix2.txt");
+    file >> matrix;
+    file.close();
+
+    // A + A* is hermitian, imaginary parts are added to off-diagonal elements in conjugate pairs
+    Matrix<std::complex<double>> hermitian = matrix + conj(matrix);
+    for (std::size_t i = 0; i < hermitian.n(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            hermitian[i, j] += std::complex<double>(0, double(i + j));
+            hermitian[j, i] -= std::complex<double>(0, double(i + j));
+        }
+    }
+
+    std::cout << "matrix:" << '\n';
+    std::cout << hermitian;
+    std::cout << '\n' << '\n';
+
+    std::cout << "matrix is hermitian:" << '\n';
+    std::cout << is_hermitian(hermitian);
+    std::cout << '\n' << '\n';
+
+    auto eigenparis = hermitian_eigenpairs(hermitian);
+    auto vectors = Matrix<std::complex<double>>(hermitian.n(), hermitian.n());
+    for (int i = 0; i < eigenparis.size(); ++i) {
+        auto eigenvalue = eigenparis[i].first;
+        auto eigenvector = eigenparis[i].second;
+        vectors[Slice(0, hermitian.n()), i] = eigenvector;
+
+        std::cout << "eigenvector with eigenvalue " << eigenvalue << ":" << '\n';
+        std::cout << eigenvector;
+        std::cout << '\n' << '\n';
+
+        std::cout << "residual norm:" << '\n';
+        std::cout << norm(hermitian * eigenvector - std::complex<double>(eigenvalue) * eigenvector);
+        std::cout << '\n' << '\n';
+    }
+
+    Matrix<std::complex<double>> orthogonality = conj(vectors) * vectors - identity<std::complex<double>>(hermitian.n());
+    std::cout << "eigenvectors are orthonormal:" << '\n';
+    std::cout << (m_norm(orthogonality) < 1e-13);
+}
+
+void eigenvalues_test() {
+    std::cout << "eigenvalues without eigenvectors test";
+    std::cout << '\n' << '\n';
+
+    Matrix<double> matrix;
+    std::ifstream file;
+    file.open("../matrix/matrix2.txt");
+    file >> matrix;
+    file.close();
+
+    // Schur vectors don't change the Schur form, so eigenvalues are the same as ones of eigenpairs
+    Matrix<std::complex<double>> complex_matrix = matrix;
+    auto real_values = eigenvalues(matrix);
+    auto complex_values = eigenvalues(complex_matrix);
+    auto real_pairs = eigenpairs(matrix);
+    auto complex_pairs = eigenpairs(complex_matrix);
+
+    bool real_equal = true;
+    bool complex_equal = true;
+    std::cout << "eigenvalues:" << '\n';
+    for (int i = 0; i < real_values.size(); ++i) {
+        std::cout << real_values[i] << ' ';
+        real_equal = real_equal && real_values[i] == real_pairs[i].first;
+        complex_equal = complex_equal && complex_values[i] == complex_pairs[i].first;
+    }
+    std::cout << '\n' << '\n';
+
+    std::cout << "eigenvalues are equal to ones of eigenpairs in real and complex arithmetic:" << '\n';
+    std::cout << real_equal << ' ' << complex_equal;
+}
+
+void schur_eigenvectors_test() {
+    std::cout << "all eigenvectors of triangular matrix test";
+    std::cout << '\n' << '\n';
+
+    // close eigenvalues and large elements above diagonal make unscaled back-substitution overflow
+    std::size_t n = 60;
+    auto matrix = Matrix<std::complex<double>>(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        matrix[i, i] = std::complex<double>(1e-8 * double(i), 1e-8);
+        for (std::size_t j = i+1; j < n; ++j) {
+            matrix[i, j] = std::complex<double>(1e8, std::cos(double(i + j)));
+        }
+    }
+
+    auto vectors = schur_eigenvectors(matrix);
+    bool finite = true;
+    bool small = true;
+    for (std::size_t k = 0; k < n; ++k) {
+        Matrix<std::complex<double>> eigenvector = vectors[Slice(0, n), k];
+        finite = finite && std::isfinite(norm(eigenvector));
+        eigenvector /= std::complex<double>(norm(eigenvector));
+        small = small && norm(matrix * eigenvector - matrix[k, k] * eigenvector) < 1e-6 * m_norm(matrix);
+    }
+    std::cout << "all eigenvectors are finite:" << '\n';
+    std::cout << finite << '\n';
+    std::cout << "residual norms are small:" << '\n';
+    std::cout << small;
+}
+
+void decomposition_objects_test() {
+    std::cout << "Hessenberg and Schur decompositions with householder sequences test";
+    std::cout << '\n' << '\n';
+
+    // size is large enough for blocked reduction
+    std::size_t n = 200;
+    auto matrix = Matrix<double>(n, n);
+    auto x = Matrix<double>(n, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i, 0] = std::cos(double(i));
+        for (std::size_t j = 0; j < n; ++j) {
+            matrix[i, j] = std::sin(double(i * i + 7 * j * j + i * j));
+        }
+    }
+
+    auto hessenberg_decomposition = HessenbergDecomposition<double>(matrix);
+    Matrix<double> Q = hessenberg_decomposition.materialize_Q();
+    Matrix<double> H = hessenberg_decomposition.H();
+    Matrix<double> error = matrix - Q * H * conj(Q);
+    std::cout << "Hessenberg decomposition is correct:" << '\n';
+    std::cout << (m_norm(error) / m_norm(matrix) < 1e-13) << '\n';
+
+    // Q applied to vector by reflectors is the same as product with dense Q, Q* reverts it
+    Matrix<double> y = hessenberg_decomposition.Q() * x;
+    Matrix<double> dense_y = Q * x;
+    Matrix<double> z = y;
+    hessenberg_decomposition.apply_Qh(z);
+    std::cout << "reflectors are applied to vector as dense Q and Q*:" << '\n';
+    std::cout << (norm(y - dense_y) < 1e-13 * norm(x)) << ' ' << (norm(z - x) < 1e-13 * norm(x)) << '\n';
+
+    // Q of temporary decomposition keeps its reflectors
+    auto kept_Q = HessenbergDecomposition<double>(matrix).Q();
+    auto kept_Qh = conj(kept_Q);
+    Matrix<double> kept_y = x;
+    kept_Q.apply(kept_y);
+    Matrix<double> kept_z = kept_y;
+    kept_Qh.apply(kept_z);
+    std::cout << "Q outlives its decomposition:" << '\n';
+    std::cout << (norm(kept_y - dense_y) < 1e-13 * norm(x)) << ' ' << (norm(kept_z - x) < 1e-13 * norm(x)) << '\n';
+
+    auto schur_decomposition = SchurDecomposition<double>(matrix);
+    Matrix<double> schur_Q = schur_decomposition.materialize_Q();
+    Matrix<double> T = schur_decomposition.schur_form();
+    Matrix<double> schur_error = matrix - schur_Q * T * conj(schur_Q);
+    Matrix<double> schur_y = x;
+    schur_decomposition.apply_Q(schur_y);
+    Matrix<double> dense_schur_y = schur_Q * x;
+    std::cout << "Schur decomposition is correct and its Q is applied to vector:" << '\n';
+    std::cout << (m_norm(schur_error) / m_norm(matrix) < 1e-12) << ' ' << (norm(schur_y - dense_schur_y) < 1e-13 * norm(x));
+}
+
+void batched_eigenpairs_test() {
+    std::cout << "batched eigenpairs test";
+    std::cout << '\n' << '\n';
+
+    Matrix<std::complex<double>> matrix;
+    std::ifstream file;
+    file.open("../matrix/complex_matrix.txt");
+    file >> matrix;
+    file.close();
+
+    // batch holds the matrix, its hermitian part and shifted copies of it
+    std::size_t n = matrix.n();
+    std::size_t count = 50;
+    auto batch = std::vector<std::complex<double>>(count * n * n);
+    auto matrices = std::vector<Matrix<std::complex<double>>>(count);
+    for (std::size_t b = 0; b < count; ++b) {
+        matrices[b] = (b == 1 ? Matrix<std::complex<double>>(matrix + conj(matrix)) : matrix);
+        for (std::size_t i = 0; i < n; ++i) {
+            matrices[b][i, i] += double(b / 2);
+            for (std::size_t j = 0; j < n; ++j) {
+                batch[b * n * n + i * n + j] = matrices[b][i, j];
+            }
+        }
+    }
+
+    auto values = std::vector<std::complex<double>>(count * n);
+    auto vectors = std::vector<std::complex<double>>(count * n * n);
+    batched_eigenpairs(count, n, batch.data(), values.data(), vectors.data());
+
+    std::cout << "eigenvalues of the first matrix:" << '\n';
+    for (std::size_t k = 0; k < n; ++k) {
+        std::cout << values[k] << ' ';
+    }
+    std::cout << '\n' << '\n';
+
+    bool equal = true;
+    for (std::size_t b = 0; b < count; ++b) {
+        auto single = eigenpairs(matrices[b]);
+        for (std::size_t k = 0; k < n; ++k) {
+            equal = equal && single[k].first == values[b * n + k];
+            for (std::size_t i = 0; i < n; ++i) {
+                equal = equal && single[k].second[i, 0] == vectors[b * n * n + i * n + k];
+            }
+        }
+    }
+    std::cout << "batched results are equal to ones of eigenpairs:" << '\n';
+    std::cout << equal;
+}
+
+void krylov_eigenpairs_test() {
+    std::cout << "krylov eigenpairs test";
+    std::cout << '\n' << '\n';
+
+    std::size_t n = 200;
+    auto A = Matrix<double>(n, n);
+    auto B = Matrix<double>(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            A[i, j] = std::sin(double(i * n + j)) + (i == j ? double(i) / 10 : 0);
+            B[i, j] = std::cos(double(i + 3 * j)) / double(n) + (i == j ? 1 : 0);
+        }
+    }
+
+    // lazy product is only multiplied by vectors, its dense values come from the materialized product
+    auto options = KrylovOptions();
+    options.count = 4;
+    auto krylov = arnoldi_eigenpairs(A * B, options);
+    Matrix<double> product = A * B;
+    auto dense = eigenvalues(product);
+    std::stable_sort(dense.begin(), dense.end(), [](auto first, auto second) {
+        return std::abs(first) > std::abs(second);
+    });
+
+    double value_error = 0;
+    double residual = 0;
+    for (std::size_t k = 0; k < options.count; ++k) {
+        std::cout << krylov[k].first << ' ';
+        // conjugate pair of equal magnitudes may be listed in either order
+        double distance = std::min(std::abs(krylov[k].first - dense[k]), std::abs(krylov[k].first - std::conj(dense[k])));
+        value_error = std::max(value_error, distance / std::abs(dense[k]));
+        Matrix<std::complex<double>> complex_product = product;
+        residual = std::max(residual, norm(complex_product * krylov[k].second - krylov[k].first * krylov[k].second));
+    }
+    std::cout << '\n' << '\n';
+    std::cout << "arnoldi eigenvalues match dense ones: " << (value_error < 1e-8) << '\n';
+    std::cout << "arnoldi residuals are small: " << (residual < 1e-6 * std::abs(dense[0])) << '\n' << '\n';
+
+    // second difference operator has eigenvalues 2 - 2cos(k pi / (size + 1)) and is given only by callback
+    std::size_t size = 1000;
+    auto laplacian = [size](const Matrix<double> &x, Matrix<double> &y) {
+        for (std::size_t i = 0; i < size; ++i) {
+            y[i, 0] = 2 * x[i, 0] - (i > 0 ? x[i-1, 0] : 0) - (i + 1 < size ? x[i+1, 0] : 0);
+        }
+    };
+    options.count = 3;
+    options.target = Spectrum::largest_real;
+    auto lanczos = lanczos_eigenpairs<double>(size, laplacian, options);
+
+    double lanczos_error = 0;
+    double orthogonality = 0;
+    for (std::size_t k = 0; k < options.count; ++k) {
+        double exact = 2 - 2 * std::cos(double(size - k) * M_PI / double(size + 1));
+        lanczos_error = std::max(lanczos_error, std::abs(lanczos[k].first - exact));
+        for (std::size_t l = 0; l < options.count; ++l) {
+            Matrix<double> dot = conj(lanczos[k].second) * lanczos[l].second;
+            orthogonality = std::max(orthogonality, std::abs(dot[0, 0] - (k == l ? 1 : 0)));
+        }
+    }
+    std::cout << "lanczos eigenvalues match exact ones: " << (lanczos_error < 1e-8) << '\n';
+    std::cout << "lanczos eigenvectors are orthonormal: " << (orthogonality < 1e-10) << '\n' << '\n';
+
+    // the smallest eigenvalues of hermitian part of A
+    options.target = Spectrum::smallest_real;
+    Matrix<double> symmetric = A + conj(A);
+    auto smallest = lanczos_eigenpairs(symmetric, options);
+    auto all = hermitian_eigenvalues(symmetric);
+    double smallest_error = 0;
+    for (std::size_t k = 0; k < options.count; ++k) {
+        smallest_error = std::max(smallest_error, std::abs(smallest[k].first - all[k]));
+    }
+    std::cout << "smallest lanczos eigenvalues match dense ones: " << (smallest_error < 1e-8) << '\n';
+}
+
+void eigen_workspace_test() {
+    std::cout << "eigen workspace test";
+    std::cout << '\n' << '\n';
+
+    std::size_t n = 100;
+    auto general = Matrix<double>(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            general[i, j] = std::sin(double(i * i + 7 * j * j + i * j));
+        }
+    }
+    Matrix<double> symmetric = general + conj(general);
+
+    std::cout << "bytes of workspace for 100 x 100 real matrices:" << '\n';
+    std::cout << EigenWorkspace<double>::bytes(n) << '\n' << '\n';
+
+    // one workspace serves matrices of different kinds, results are the same as without it
+    auto workspace = EigenWorkspace<double>(n);
+    auto values = std::vector<std::complex<double>>(n);
+    auto vectors = std::vector<std::complex<double>>(n * n);
+    bool equal = true;
+    for (std::size_t repeat = 0; repeat < 2; ++repeat) {
+        for (const Matrix<double> &source : {general, symmetric}) {
+            Matrix<double> matrix = source;
+            eigenpairs(matrix, values.data(), vectors.data(), workspace);
+            auto expected = eigenpairs(source);
+            for (std::size_t k = 0; k < n; ++k) {
+                equal = equal && values[k] == expected[k].first;
+                for (std::size_t i = 0; i < n; ++i) {
+                    equal = equal && vectors[i * n + k] == expected[k].second[i, 0];
+                }
+            }
+
+            matrix = source;
+            eigenvalues(matrix, values.data(), workspace);
+            auto expected_values = eigenvalues(source);
+            for (std::size_t k = 0; k < n; ++k) {
+                equal = equal && values[k] == expected_values[k];
+            }
+        }
+    }
+    std::cout << "eigenpairs with workspace are equal to eigenpairs without it:" << '\n';
+    std::cout << equal;
+}
+
 int main() {
     conjugation_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
     norm_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
+    householder_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
     real_hessenberg_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
     complex_hessenberg_test();
@@ -424,6 +880,26 @@ int main() {
     eigenpairs_real_matrix_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
     eigenpairs_test();
-//    std::cout << "\n\n" << "-----------------" << "\n\n";
-//    real_schur_test();
-}
\ No newline at end of file
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    real_schur_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    eigenpairs_real_arithmetic_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    large_schur_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    blocked_hessenberg_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    hermitian_eigenpairs_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    eigenvalues_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    schur_eigenvectors_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    decomposition_objects_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    batched_eigenpairs_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    krylov_eigenpairs_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    eigen_workspace_test();
+}
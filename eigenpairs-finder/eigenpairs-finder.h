@@ -2,7 +2,12 @@
 #define MATRIX_CALCULATOR_EIGENPAIRS_FINDER_H
 
 #include <complex>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "../matrix/matrix.h"
+#include "../matrix/fixed-matrix/fixed-matrix.h"
 
 // class of conjugation operation
 // T - type of elements of matrix obtained by evaluating conjugation of the expression
@@ -13,6 +18,9 @@ private:
     std::conditional_t<E::has_data, const E&, E> expression;
 
 public:
+    // conjugation of expression lying in memory is described by the same memory with swapped strides
+    static constexpr bool has_storage = E::has_storage;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating conjugation of the expression
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -20,6 +28,17 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // return description of memory occupied by conjugated expression, available if E::has_storage
+    StorageView<T> view() const;
+
+    // returns true if evaluating conjugation of the expression may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare expression for evaluation and release it (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
     explicit Conjugation(const MatrixExpression<T, E> &expression);
 };
 
@@ -30,6 +49,10 @@ double conj(double val);
 template<typename T, typename E>
 Conjugation<T, E> conj(const MatrixExpression<T, E> & expression);
 
+// conjugation of fixed-size matrix is evaluated immediately
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Cols, Rows> conj(const FixedMatrix<T, Rows, Cols> &matrix);
+
 // 2-norm of vector
 template<typename T, typename E>
 double norm(const MatrixExpression<T, E> &vector);
@@ -42,6 +65,78 @@ double m_norm(const MatrixExpression<T, E> &matrix);
 template<typename T>
 Matrix<T> identity(std::size_t size);
 
+// makes matrix identity of size "size" in place, memory of matrix is reused
+template<typename T>
+void make_identity(Matrix<T> &matrix, std::size_t size);
+
+// real type of elements of type T: T itself or type of parts of complex number
+template<typename T>
+struct RealPart {
+    using type = T;
+};
+
+template<typename T>
+struct RealPart<std::complex<T>> {
+    using type = T;
+};
+
+// reusable workspace //
+
+// buffers of eigen solvers prepared once for n x n matrices, so repeated solutions of matrices of that size
+// don't allocate memory. Functions taking workspace resize buffers they use, which reuses memory of larger sizes;
+// contents of buffers between calls are unspecified. Workspace can't be shared by threads
+// T - type of elements of solved matrices
+template<typename T>
+struct EigenWorkspace {
+    using R = typename RealPart<T>::type;
+
+    // reflectors of Hessenberg or tridiagonal reduction as HouseholderSequence keeps them
+    Matrix<T> reflectors;
+
+    // panel V of reflectors, triangular factor T of I - VTV* and Y = AVT of blocked reduction
+    Matrix<T> panel;
+    Matrix<T> factor;
+    Matrix<T> panel_product;
+
+    // products of block of reflectors with matrix and update of matrix they give
+    Matrix<T> projection;
+    Matrix<T> weights;
+    Matrix<T> update;
+
+    // column of matrix, householder vector and short vectors of coefficients of panel
+    Matrix<T> column;
+    Matrix<T> reflector;
+    Matrix<T> coefficients;
+    Matrix<T> scaled_coefficients;
+
+    // unitary matrix of QR iterations, window of aggressive early deflation with its Schur vectors and shifts
+    Matrix<T> schur_vectors;
+    Matrix<T> window;
+    Matrix<T> window_vectors;
+    Matrix<T> shifts;
+
+    // eigenvectors of Schur form, solution of triangular system and bounds of its growth
+    Matrix<T> eigenvectors;
+    std::vector<std::complex<R>> solution;
+    std::vector<R> row_norms;
+
+    // tridiagonal matrix, rotations of its QR iterations, phases which make it real and order of its eigenvalues
+    std::vector<R> diagonal;
+    std::vector<R> subdiagonal;
+    Matrix<R> rotations;
+    std::vector<T> phases;
+    std::vector<std::size_t> order;
+
+    // prepares buffers for n x n matrices
+    void reserve(std::size_t n);
+
+    // returns count of bytes of buffers prepared for n x n matrices
+    static std::size_t bytes(std::size_t n);
+
+    // workspace of size 0 allocates buffers when they are used first
+    explicit EigenWorkspace(std::size_t n = 0);
+};
+
 // Hessenberg decomposition //
 
 // return householder vector which used in householder projection
@@ -51,42 +146,395 @@ Matrix<double> householder_vector(const MatrixExpression<double, E> &expression)
 template<typename T, typename E>
 Matrix<std::complex<T>> householder_vector(const MatrixExpression<std::complex<T>, E> &expression);
 
-// functions which apply householder reflector with householder vector "v" to "matrix" //
+// turns vector into householder vector reflecting it onto its first axis in place
+template<typename T>
+void make_householder_vector(Submatrix<T> vector);
+
+// functions which apply householder reflector I - 2vv* with householder vector "v" to "submatrix" in place //
+// one pass computes product of "submatrix" and "v", another one subtracts rank-1 update, no temporary matrix is made
 
-// apply householder projection on left of "submatrix"
-template<typename T1, typename T2, typename E2>
-void left_h_transformation(Submatrix<T1> submatrix, const MatrixExpression<T2, E2> &v);
+// apply householder reflector on left of "submatrix": A -= 2v(v*A)
+template<typename T, typename E>
+void apply_householder_left(Submatrix<T> submatrix, const MatrixExpression<T, E> &v);
+
+// apply householder reflector on right of "submatrix": A -= 2(Av)v*
+template<typename T, typename E>
+void apply_householder_right(Submatrix<T> submatrix, const MatrixExpression<T, E> &v);
 
-// apply householder projection on right of "submatrix"
-template<typename T1, typename T2, typename E2>
-void right_h_transformation(Submatrix<T1> submatrix, const MatrixExpression<T2, E2> &v);
+// returns householder vector of fixed-size vector, no memory is allocated
+template<typename T, std::size_t N>
+FixedMatrix<T, N, 1> householder_vector(const FixedMatrix<T, N, 1> &vector);
+
+// apply reflector I - 2vv* with fixed-size householder vector "v" on left or right of "submatrix" in place.
+// Short reflectors of bulge chasing are applied by plain loops instead of matrix-vector kernels
+template<typename T, std::size_t N>
+void reflect_rows(Submatrix<T> submatrix, const FixedMatrix<T, N, 1> &v);
+
+template<typename T, std::size_t N>
+void reflect_columns(Submatrix<T> submatrix, const FixedMatrix<T, N, 1> &v);
+
+// return and set number of columns reduced by one panel of blocked Hessenberg reduction, 1 turns blocking off
+std::size_t hessenberg_block_size();
+void set_hessenberg_block_size(std::size_t size);
+
+// reduces "size" columns of matrix starting from k-th one and accumulates their reflectors into compact WY form
+// I - VTV*, V is written to workspace.panel and T to workspace.factor. Y = AVT is computed to workspace.panel_product
+// for update of the rest of matrix from the right, columns after the panel aren't changed
+template<typename T>
+void reduce_hessenberg_panel(Matrix<T> &matrix, std::size_t k, std::size_t size, EigenWorkspace<T> &workspace);
+
+// reduces square matrix to upper Hessenberg form H in place, reflectors are left in workspace.reflectors
+template<typename T>
+void reduce_hessenberg(Matrix<T> &matrix, EigenWorkspace<T> &workspace);
+
+// class of unitary matrix Q = H_0 H_1 ... H_{m-1} or its conjugate Q* kept as householder reflectors
+// H_k = I - 2v_k v_k*, which are applied by blocks with matrix products instead of forming Q
+// T - type of elements
+template<typename T>
+class HouseholderSequence {
+private:
+    // k-th column holds v_k in rows starting from k+1, zero column stands for identity.
+    // Sequences of decompositions share ownership of reflectors, sequences of workspace reflectors only refer to them
+    std::shared_ptr<const Matrix<T>> owner;
+    const Matrix<T> &reflectors;
+    bool adjoint;
+
+    // writes upper triangular T of compact form I - VTV* of product of reflectors [begin, end) to workspace.factor
+    void factor(std::size_t begin, std::size_t end, EigenWorkspace<T> &workspace) const;
+
+    // multiplies columns of "matrix" starting from "first_column" by product of reflectors [begin, end)
+    // or by its conjugate on the left
+    void apply_block(Matrix<T> &matrix, std::size_t begin, std::size_t end, std::size_t first_column,
+                     EigenWorkspace<T> &workspace) const;
+
+public:
+    // return size of Q
+    std::size_t n() const;
+    std::size_t m() const;
+
+    // multiplies "matrix" by Q (Q* for conjugated sequence) on the left in place, O(n^2) per column
+    void apply(Matrix<T> &matrix) const;
+    void apply(Matrix<T> &matrix, EigenWorkspace<T> &workspace) const;
+
+    // returns Q (Q* for conjugated sequence) as dense matrix
+    Matrix<T> materialize() const;
+
+    // sequence refers to "reflectors", which must outlive it
+    explicit HouseholderSequence(const Matrix<T> &reflectors, bool adjoint = false);
+
+    // sequence shares ownership of "reflectors"
+    explicit HouseholderSequence(std::shared_ptr<const Matrix<T>> reflectors, bool adjoint = false);
+
+    template<typename T1>
+    friend HouseholderSequence<T1> conj(const HouseholderSequence<T1> &sequence);
+};
+
+// returns sequence of conjugated matrix, which shares or refers to the same reflectors
+template<typename T>
+HouseholderSequence<T> conj(const HouseholderSequence<T> &sequence);
+
+// returns product of unitary matrix kept as householder sequence and expression, product is evaluated at once:
+// expression is evaluated into the result and reflectors are applied to it in place
+template<typename T, typename E>
+Matrix<T> operator*(const HouseholderSequence<T> &sequence, const MatrixExpression<T, E> &expression);
+
+// class of Hessenberg decomposition A=QHQ*, Q is kept as householder sequence
+// T - type of elements
+template<typename T>
+class HessenbergDecomposition {
+private:
+    Matrix<T> hessenberg_matrix;
+    std::shared_ptr<const Matrix<T>> reflectors;
+
+public:
+    // returns upper Hessenberg matrix H
+    const Matrix<T>& H() const;
+
+    // returns Q which shares reflectors of decomposition, so it may outlive the decomposition
+    HouseholderSequence<T> Q() const;
+
+    // multiply "matrix" by Q or Q* on the left in place
+    void apply_Q(Matrix<T> &matrix) const;
+    void apply_Qh(Matrix<T> &matrix) const;
+
+    // returns Q as dense matrix
+    Matrix<T> materialize_Q() const;
+
+    // decomposes square matrix
+    explicit HessenbergDecomposition(Matrix<T> matrix);
+};
 
 // decomposes matrix A. A=QHQ* where Q - unitary matrix, H - upper Hessenberg matrix.
-// H overwrites matrix, Q returned;
+// H overwrites matrix, Q returned; Q isn't formed and empty matrix is returned if "accumulate" is false
 template<typename T>
-Matrix<T> hessenberg(Matrix<T> &matrix);
+Matrix<T> hessenberg(Matrix<T> &matrix, bool accumulate = true);
 
 // returns 2x2 givens matrix which transform vector (x, y)* to (0, z)
 template<typename T>
-Matrix<T> givens(T x, T y);
+FixedMatrix<T, 2, 2> givens(T x, T y);
+
+// multiplies 2 x m "submatrix" by "rotation" on the left in place
+template<typename T>
+void rotate_rows(Submatrix<T> submatrix, const FixedMatrix<T, 2, 2> &rotation);
+
+// multiplies n x 2 "submatrix" by "rotation" on the right in place
+template<typename T>
+void rotate_columns(Submatrix<T> submatrix, const FixedMatrix<T, 2, 2> &rotation);
 
 // performs QR step of hessenberg matrix by overriding matrix, returns Q matrix
 template<typename T>
 Matrix<T> QR_step(Matrix<T> &matrix);
 
+// performs implicit QR step with "shift" on rows and columns [begin, end) of hessenberg matrix by chasing bulge
+// with givens rotations. Updates whole matrix and accumulates transformation into Q unless Q is empty
+template<typename T>
+void shifted_QR_step(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end, T shift);
+
+// returns first row of unreduced hessenberg block which ends before "end" row. Subdiagonal element is negligible
+// if it is small relative to its diagonal neighbours, such element is set to zero
+template<typename T>
+std::size_t active_block_begin(Matrix<T> &matrix, std::size_t end, double matrix_norm);
+
+// tries to deflate eigenvalues at the bottom of active block [begin, end) of hessenberg matrix by Schur
+// decomposition of trailing window. Returns number of deflated eigenvalues, accumulates transformation into Q
+// unless Q is empty.
+// Schur form of the part of window which wasn't deflated is written to workspace.shifts, its eigenvalues
+// are good shifts
+template<typename T>
+std::size_t aggressive_early_deflation(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end,
+                                      EigenWorkspace<T> &workspace);
+
 // decomposes upper heisenberg matrix to QTQ* where T is upper triangular and Q is unitary.
-// Overwrites matrix with T and returns Q
+// Overwrites matrix with T and returns Q, empty matrix is returned if "accumulate" is false.
+// Throws std::runtime_error if iterations don't converge
 template<typename T>
-Matrix<std::complex<T>> complex_schur(Matrix<std::complex<T>> &matrix);
+Matrix<std::complex<T>> complex_schur(Matrix<std::complex<T>> &matrix, bool accumulate = true);
+
+// decomposes upper hessenberg matrix as complex_schur does, transformation is accumulated into Q on the right
+// unless Q is empty
+template<typename T>
+void complex_schur(Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &Q,
+                   EigenWorkspace<std::complex<T>> &workspace);
 
 // returns eigenvector associated with eigenvalue on value_index'th diagonal element of triangular matrix
 template<typename T>
 Matrix<std::complex<T>> schur_eigenvector(Matrix<std::complex<T>> matrix, std::size_t value_index);
 
-// returns vector of eigenpairs of matrix
+// returns matrix whose k-th column is eigenvector associated with eigenvalue on k-th diagonal element of
+// triangular matrix. All vectors are found in one pass over the matrix, solution is scaled to avoid overflow
+// and the largest element of every column is 1
+template<typename T>
+Matrix<std::complex<T>> schur_eigenvectors(const Matrix<std::complex<T>> &matrix);
+
+// writes eigenvectors of triangular matrix to "result" as schur_eigenvectors does
+template<typename T>
+void schur_eigenvectors(const Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &result,
+                        EigenWorkspace<std::complex<T>> &workspace);
+
+// returns vector of eigenpairs made of "values" and columns of row-major n x n array "vectors"
+template<typename T>
+std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs_from(std::size_t n, const std::complex<T> *values,
+                                                                                const std::complex<T> *vectors);
+
+// writes eigenvalues of matrix to "values" and normalized eigenvectors to columns of row-major n x n array
+// "vectors" in the same order, matrix is overwritten. Hermitian matrix is solved by hermitian_eigenpairs
+template<typename T>
+void eigenpairs(Matrix<std::complex<T>> &matrix, std::complex<T> *values, std::complex<T> *vectors);
+
+// writes eigenpairs of matrix to arrays as eigenpairs does, all buffers are taken from "workspace", so no memory
+// is allocated if workspace was prepared for matrix of this size
+template<typename T>
+void eigenpairs(Matrix<std::complex<T>> &matrix, std::complex<T> *values, std::complex<T> *vectors,
+                EigenWorkspace<std::complex<T>> &workspace);
+
+// returns vector of eigenpairs of matrix, hermitian matrix is solved by hermitian_eigenpairs
 template<typename T>
 std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs(Matrix<std::complex<T>> matrix);
 
+// real Schur decomposition //
+
+// returns eigenvalue with non-negative imaginary part of 2x2 diagonal block starting at k-th row
+template<typename T>
+std::complex<T> block_eigenvalue(const Matrix<T> &matrix, std::size_t k);
+
+// performs implicit double shift QR step on rows and columns [begin, end) of real hessenberg matrix,
+// shifts are roots of x^2 - sx + t. Updates whole matrix and accumulates transformation into Q unless Q is empty
+template<typename T>
+void francis_step(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end, T s, T t);
+
+// makes 2x2 diagonal block starting at k-th row upper triangular if its eigenvalues are real,
+// accumulates transformation into Q unless Q is empty
+template<typename T>
+void split_block(Matrix<T> &matrix, Matrix<T> &Q, std::size_t k);
+
+// decomposes real upper hessenberg matrix to QTQ* where T is quasi upper triangular and Q is orthogonal.
+// 2x2 diagonal blocks of T hold complex conjugate eigenvalues. Overwrites matrix with T and returns Q,
+// empty matrix is returned if "accumulate" is false. Throws std::runtime_error if iterations don't converge
+template<typename T>
+Matrix<T> real_schur(Matrix<T> &matrix, bool accumulate = true);
+
+// decomposes real upper hessenberg matrix as real_schur does, transformation is accumulated into Q on the right
+// unless Q is empty
+template<typename T>
+void real_schur(Matrix<T> &matrix, Matrix<T> &Q, EigenWorkspace<T> &workspace);
+
+// Schur decomposition of hessenberg matrix in arithmetic of its elements: real or complex one
+template<typename T>
+Matrix<T> schur(Matrix<T> &matrix, bool accumulate = true);
+
+template<typename T>
+Matrix<std::complex<T>> schur(Matrix<std::complex<T>> &matrix, bool accumulate = true);
+
+template<typename T>
+void schur(Matrix<T> &matrix, Matrix<T> &Q, EigenWorkspace<T> &workspace);
+
+template<typename T>
+void schur(Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &Q, EigenWorkspace<std::complex<T>> &workspace);
+
+// class of Schur decomposition A=QTQ* in arithmetic of elements of matrix. Q = Q_H Z where Q_H is kept
+// as householder sequence of Hessenberg decomposition and Z is dense unitary matrix of QR iterations
+// T - type of elements
+template<typename T>
+class SchurDecomposition {
+private:
+    HessenbergDecomposition<T> reduction;
+    Matrix<T> schur_matrix;
+    Matrix<T> schur_vectors;
+
+public:
+    // returns triangular (quasi triangular for real matrix) factor T
+    const Matrix<T>& schur_form() const;
+
+    // return Hessenberg decomposition which precedes QR iterations and unitary matrix Z of the iterations
+    const HessenbergDecomposition<T>& hessenberg_decomposition() const;
+    const Matrix<T>& Z() const;
+
+    // multiply "matrix" by Q or Q* on the left in place
+    void apply_Q(Matrix<T> &matrix) const;
+    void apply_Qh(Matrix<T> &matrix) const;
+
+    // returns Q as dense matrix
+    Matrix<T> materialize_Q() const;
+
+    // decomposes square matrix, throws std::runtime_error if iterations don't converge
+    explicit SchurDecomposition(Matrix<T> matrix);
+};
+
+// returns eigenvectors of quasi triangular matrix. Column of real eigenvalue holds its eigenvector,
+// two columns of conjugate pair hold real and imaginary parts of eigenvector of value with positive imaginary part
+template<typename T>
+Matrix<T> real_schur_eigenvectors(const Matrix<T> &matrix);
+
+// writes eigenvectors of quasi triangular matrix to "result" as real_schur_eigenvectors does
+template<typename T>
+void real_schur_eigenvectors(const Matrix<T> &matrix, Matrix<T> &result, EigenWorkspace<T> &workspace);
+
+// writes eigenpairs of real matrix computed in real arithmetic to arrays as eigenpairs of complex matrix does
+template<typename T>
+void eigenpairs(Matrix<T> &matrix, std::complex<T> *values, std::complex<T> *vectors);
+
+// writes eigenpairs of real matrix to arrays with buffers taken from "workspace"
+template<typename T>
+void eigenpairs(Matrix<T> &matrix, std::complex<T> *values, std::complex<T> *vectors, EigenWorkspace<T> &workspace);
+
+// returns vector of eigenpairs of real matrix, computed in real arithmetic. Symmetric matrix is solved by
+// hermitian_eigenpairs
+template<typename T>
+std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs(Matrix<T> matrix);
+
+// Hermitian eigenproblem //
+
+// returns true if matrix is equal to its conjugate transpose
+template<typename T>
+bool is_hermitian(const Matrix<T> &matrix);
+
+// decomposes hermitian matrix A. A=QTQ* where Q - unitary matrix, T - real symmetric tridiagonal matrix.
+// T overwrites matrix, Q returned; Q isn't accumulated and empty matrix is returned if "accumulate" is false
+template<typename T>
+Matrix<T> tridiagonal(Matrix<T> &matrix, bool accumulate = true);
+
+// reduces hermitian matrix to real tridiagonal T in place. A = Q_H D T D* Q_H*, where reflectors of Q_H are left
+// in workspace.reflectors and diagonal of unitary D in workspace.phases
+template<typename T>
+void tridiagonal(Matrix<T> &matrix, EigenWorkspace<T> &workspace);
+
+// performs implicit QR step with "shift" on rows and columns [begin, end) of symmetric tridiagonal matrix
+// given by "diagonal" and "subdiagonal". Rotations are accumulated into rows of Z unless Z is empty
+template<typename T>
+void tridiagonal_QR_step(std::vector<T> &diagonal, std::vector<T> &subdiagonal, Matrix<T> &Z,
+                         std::size_t begin, std::size_t end, T shift);
+
+// finds eigenvalues of symmetric tridiagonal matrix, overwrites "diagonal" with them in order of deflation.
+// Rotations are accumulated into rows of Z unless Z is empty. Throws std::runtime_error if iterations don't converge
+template<typename T>
+void tridiagonal_QR(std::vector<T> &diagonal, std::vector<T> &subdiagonal, Matrix<T> &Z);
+
+// finds eigenvalues of symmetric tridiagonal matrix, overwrites "diagonal" with them in ascending order.
+// Returns orthogonal matrix whose rows are corresponding eigenvectors, empty matrix if "accumulate" is false.
+// Throws std::runtime_error if iterations don't converge
+template<typename T>
+Matrix<T> tridiagonal_eigenpairs(std::vector<T> &diagonal, std::vector<T> &subdiagonal, bool accumulate = true);
+
+// returns vector of eigenpairs of hermitian matrix: real eigenvalues in ascending order and orthonormal eigenvectors
+template<typename T>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>> hermitian_eigenpairs(Matrix<T> matrix);
+
+// writes eigenvalues of hermitian matrix in ascending order to "values" and orthonormal eigenvectors to columns
+// of row-major n x n array "vectors", matrix is overwritten. Eigenvectors are back-transformed by reflectors
+// of tridiagonal reduction without forming Q.
+// V, U - types of elements of arrays, constructible from real numbers and from T
+template<typename T, typename V, typename U>
+void hermitian_eigenpairs(Matrix<T> &matrix, V *values, U *vectors, EigenWorkspace<T> &workspace);
+
+// eigenvalues only //
+
+// return eigenvalues of matrix in the same order as eigenpairs does, neither Schur vectors nor eigenvectors
+// are computed
+template<typename T>
+std::vector<std::complex<T>> eigenvalues(Matrix<std::complex<T>> matrix);
+
+template<typename T>
+std::vector<std::complex<T>> eigenvalues(Matrix<T> matrix);
+
+// write eigenvalues of matrix to "values", matrix is overwritten
+template<typename T>
+void eigenvalues(Matrix<std::complex<T>> &matrix, std::complex<T> *values);
+
+template<typename T>
+void eigenvalues(Matrix<T> &matrix, std::complex<T> *values);
+
+// write eigenvalues of matrix to "values" with buffers taken from "workspace"
+template<typename T>
+void eigenvalues(Matrix<std::complex<T>> &matrix, std::complex<T> *values, EigenWorkspace<std::complex<T>> &workspace);
+
+template<typename T>
+void eigenvalues(Matrix<T> &matrix, std::complex<T> *values, EigenWorkspace<T> &workspace);
+
+// returns eigenvalues of hermitian matrix in ascending order, eigenvectors aren't computed
+template<typename T>
+std::vector<typename RealPart<T>::type> hermitian_eigenvalues(Matrix<T> matrix);
+
+// writes eigenvalues of hermitian matrix in ascending order to "values", matrix is overwritten
+// V - type of elements of array, constructible from real numbers
+template<typename T, typename V>
+void hermitian_eigenvalues(Matrix<T> &matrix, V *values, EigenWorkspace<T> &workspace);
+
+// batched eigen solver //
+
+// solves eigenproblems of "count" n x n matrices lying one after another in "matrices" in row-major order.
+// Eigenvalues of b-th matrix are written to values[b*n, (b+1)*n), its eigenvectors to columns of row-major
+// n x n block starting at vectors[b*n*n], as eigenpairs does. Matrices are split between threads of the pool,
+// every thread reuses its workspace for all its matrices
+template<typename T>
+void batched_eigenpairs(std::size_t count, std::size_t n, const T *matrices,
+                        std::complex<typename RealPart<T>::type> *values,
+                        std::complex<typename RealPart<T>::type> *vectors);
+
+// writes eigenvalues of batch of matrices to "values" as batched_eigenpairs does
+template<typename T>
+void batched_eigenvalues(std::size_t count, std::size_t n, const T *matrices,
+                         std::complex<typename RealPart<T>::type> *values);
+
 #include "eigenpairs-finder.tpp"
 
 #endif //MATRIX_CALCULATOR_EIGENPAIRS_FINDER_H
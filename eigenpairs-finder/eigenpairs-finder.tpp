@@ -1,10 +1,32 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <complex>
+#include <numeric>
 #include "../matrix/matrix.h"
 
 // all numbers less than ZERO are considered 0
 const double ZERO = 1e-15;
 
+// Schur decomposition fails if it takes more than MAX_SCHUR_ITERATIONS iterations per row of matrix
+const std::size_t MAX_SCHUR_ITERATIONS = 30;
+
+// active blocks of at least AED_THRESHOLD rows try aggressive early deflation on trailing window
+// of at most AED_WINDOW rows before QR step
+const std::size_t AED_THRESHOLD = 75;
+const std::size_t AED_WINDOW = 48;
+
+// columns of matrix left after blocked Hessenberg reduction are reduced one by one
+const std::size_t HESSENBERG_CROSSOVER = 128;
+
+// number of householder reflectors applied by one matrix product
+const std::size_t REFLECTOR_BLOCK_SIZE = 32;
+
+// householder sequence is applied by blocks of reflectors to matrices with at least HOUSEHOLDER_COLUMNS columns,
+// narrower matrices don't pay off triangular factors of blocks
+const std::size_t HOUSEHOLDER_COLUMNS = 128;
+
 // Conjugation implementation //
 
 template<typename T, typename E>
@@ -22,6 +44,35 @@ std::size_t Conjugation<T, E>::m() const {
     return expression.n();
 }
 
+template<typename T, typename E>
+StorageView<T> Conjugation<T, E>::view() const {
+    StorageView<T> result = expression.view();
+    std::swap(result.row_stride, result.col_stride);
+    result.conjugated = !result.conjugated;
+    return result;
+}
+
+template<typename T, typename E>
+bool Conjugation<T, E>::aliases(const MemoryRegion &region, bool aligned) const {
+    // element on i-th row and j-th column reads element on j-th row and i-th column
+    return expression.aliases(region, false);
+}
+
+template<typename T, typename E>
+std::size_t Conjugation<T, E>::cost() const {
+    return expression.cost() + 1;
+}
+
+template<typename T, typename E>
+void Conjugation<T, E>::prepare() const {
+    expression.prepare();
+}
+
+template<typename T, typename E>
+void Conjugation<T, E>::release() const {
+    expression.release();
+}
+
 template<typename T, typename E>
 Conjugation<T, E>::Conjugation(const MatrixExpression<T, E> &expression_) :
 expression(static_cast<const E&>(expression_)) {}
@@ -35,6 +86,17 @@ Conjugation<T, E> conj(const MatrixExpression<T, E> &expression) {
     return Conjugation<T, E>(expression);
 }
 
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Cols, Rows> conj(const FixedMatrix<T, Rows, Cols> &matrix) {
+    FixedMatrix<T, Cols, Rows> result;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            result[j, i] = conj(matrix[i, j]);
+        }
+    }
+    return result;
+}
+
 template<typename T, typename E>
 double norm(const MatrixExpression<T, E> &vector) {
     if (vector.m() != 1) {
@@ -69,6 +131,64 @@ Matrix<T> identity(std::size_t size) {
     return result;
 }
 
+template<typename T>
+void make_identity(Matrix<T> &matrix, std::size_t size) {
+    matrix.resize(size, size);
+    std::fill(matrix.data(), matrix.data() + size * size, T(0));
+    for (std::size_t i = 0; i < size; ++i) {
+        matrix[i,i] = 1;
+    }
+}
+
+// reusable workspace implementation //
+
+template<typename T>
+void EigenWorkspace<T>::reserve(std::size_t n) {
+    // blocks of Hessenberg reduction and of reflector products share buffers
+    std::size_t block = std::max(hessenberg_block_size(), REFLECTOR_BLOCK_SIZE);
+    std::size_t window_size = (n >= AED_THRESHOLD ? AED_WINDOW : 0);
+
+    reflectors.resize(n, n > 2 ? n - 2 : 0);
+    panel.resize(n, block);
+    factor.resize(block, block);
+    panel_product.resize(n, block);
+    projection.resize(block, n);
+    weights.resize(block, n);
+    update.resize(n, n);
+    column.resize(n, 1);
+    reflector.resize(n, 1);
+    coefficients.resize(block, 1);
+    scaled_coefficients.resize(block, 1);
+    schur_vectors.resize(n, n);
+    window.resize(window_size, window_size);
+    window_vectors.resize(window_size, window_size);
+    shifts.resize(window_size, window_size);
+    eigenvectors.resize(n, n);
+    solution.reserve(n);
+    row_norms.reserve(n);
+    diagonal.reserve(n);
+    subdiagonal.reserve(n);
+    rotations.resize(n, n);
+    phases.reserve(n);
+    order.reserve(n);
+}
+
+template<typename T>
+std::size_t EigenWorkspace<T>::bytes(std::size_t n) {
+    std::size_t block = std::max(hessenberg_block_size(), REFLECTOR_BLOCK_SIZE);
+    std::size_t window_size = (n >= AED_THRESHOLD ? AED_WINDOW : 0);
+
+    std::size_t elements = n * (n > 2 ? n - 2 : 0) + 4 * n * block + block * block + 3 * n * n + 2 * n +
+                           2 * block + 3 * window_size * window_size;
+    return elements * sizeof(T) + n * sizeof(std::complex<R>) + (3 * n + n * n) * sizeof(R) +
+           n * sizeof(T) + n * sizeof(std::size_t);
+}
+
+template<typename T>
+EigenWorkspace<T>::EigenWorkspace(std::size_t n) {
+    reserve(n);
+}
+
 // Hessenberg decomposition implementation //
 
 template<typename E>
@@ -77,11 +197,9 @@ Matrix<double> householder_vector(const MatrixExpression<double, E> &expression)
         throw std::invalid_argument("householder vector can be obtained only from another vector");
     }
 
-    // both signs are appropriate, choose which one makes the longest hessenberg vector to improve stability
-    int sign = (expression[0,0] >= 0 ? 1 : -1);
     Matrix<double> vector = expression;
-    vector[0,0] += sign * norm(vector);
-    return vector / norm(vector);
+    make_householder_vector(vector[Slice(0, vector.n()), 0]);
+    return vector;
 }
 
 template<typename T, typename E>
@@ -91,61 +209,482 @@ Matrix<std::complex<T>> householder_vector(const MatrixExpression<std::complex<T
     }
 
     Matrix<std::complex<T>> vector = expression;
-    vector[0,0] += (vector[0,0] * norm(vector)) / std::abs(vector[0, 0]);
-    return vector / std::complex<T>(norm(vector));
+    make_householder_vector(vector[Slice(0, vector.n()), 0]);
+    return vector;
+}
+
+template<typename T>
+void make_householder_vector(Submatrix<T> vector) {
+    // any phase is appropriate, phase of the first element (sign for real one) makes the longest vector
+    // to improve stability, zero element takes phase 1
+    T first = vector[0,0];
+    T phase = (std::abs(first) != 0 ? first / T(std::abs(first)) : T(1));
+    vector[0,0] += phase * T(norm(vector));
+    vector /= T(norm(vector));
+}
+
+template<typename T, typename E>
+void apply_householder_left(Submatrix<T> submatrix, const MatrixExpression<T, E> &v) {
+    if (v.n() != submatrix.n() || v.m() != 1) {
+        throw std::invalid_argument("householder vector doesn't match rows of matrix");
+    }
+    std::size_t n = submatrix.n();
+    std::size_t m = submatrix.m();
+
+    auto v_value = ScratchBuffer<T>(n);
+    evaluate(v, v_value.data(), 1);
+
+    // w = A^T conj(v) is accumulated row by row of A
+    auto w = ScratchBuffer<T>(m);
+    std::fill(w.data(), w.data() + m, T(0));
+    gemv(m, n, StorageView<T>{submatrix.data(), 1, submatrix.ld(), false},
+         StorageView<T>{v_value.data(), 1, 0, true}, w.data(), 1);
+
+    ger(n, m, T(-2), StorageView<T>{v_value.data(), 1, 0, false}, StorageView<T>{w.data(), 1, 0, false},
+        submatrix.data(), submatrix.ld());
 }
 
-template<typename T1, typename T2, typename E2>
-void left_h_transformation(Submatrix<T1> submatrix, const MatrixExpression<T2, E2> &v) {
-    submatrix -= T2(2) * v * (conj(v) * submatrix);
+template<typename T, typename E>
+void apply_householder_right(Submatrix<T> submatrix, const MatrixExpression<T, E> &v) {
+    if (v.n() != submatrix.m() || v.m() != 1) {
+        throw std::invalid_argument("householder vector doesn't match columns of matrix");
+    }
+    std::size_t n = submatrix.n();
+    std::size_t m = submatrix.m();
+
+    auto v_value = ScratchBuffer<T>(m);
+    evaluate(v, v_value.data(), 1);
+
+    // w = Av is dot product of every row of A with v
+    auto w = ScratchBuffer<T>(n);
+    std::fill(w.data(), w.data() + n, T(0));
+    gemv(n, m, StorageView<T>{submatrix.data(), submatrix.ld(), 1, false},
+         StorageView<T>{v_value.data(), 1, 0, false}, w.data(), 1);
+
+    ger(n, m, T(-2), StorageView<T>{w.data(), 1, 0, false}, StorageView<T>{v_value.data(), 1, 0, true},
+        submatrix.data(), submatrix.ld());
 }
 
-template<typename T1, typename T2, typename E2>
-void right_h_transformation(Submatrix<T1> submatrix, const MatrixExpression<T2, E2> &v) {
-    submatrix -= T2(2) * (submatrix * v) * conj(v);
+template<typename T, std::size_t N>
+FixedMatrix<T, N, 1> householder_vector(const FixedMatrix<T, N, 1> &vector) {
+    // phase of first element is kept as in householder vector of matrix, sign for real elements
+    FixedMatrix<T, N, 1> result = vector;
+    T phase = (std::abs(result[0,0]) != 0 ? result[0,0] / std::abs(result[0,0]) : T(1));
+    result[0,0] += phase * norm(result);
+    T length = norm(result);
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i,0] /= length;
+    }
+    return result;
+}
+
+template<typename T, std::size_t N>
+void reflect_rows(Submatrix<T> submatrix, const FixedMatrix<T, N, 1> &v) {
+    if (submatrix.n() != N) {
+        throw std::invalid_argument("householder vector doesn't match rows of matrix");
+    }
+    std::array<T*, N> rows;
+    for (std::size_t i = 0; i < N; ++i) {
+        rows[i] = submatrix.data() + i * submatrix.ld();
+    }
+    for (std::size_t j = 0; j < submatrix.m(); ++j) {
+        T projection = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            projection += conj(v[i,0]) * rows[i][j];
+        }
+        projection *= T(2);
+        for (std::size_t i = 0; i < N; ++i) {
+            rows[i][j] -= v[i,0] * projection;
+        }
+    }
+}
+
+template<typename T, std::size_t N>
+void reflect_columns(Submatrix<T> submatrix, const FixedMatrix<T, N, 1> &v) {
+    if (submatrix.m() != N) {
+        throw std::invalid_argument("householder vector doesn't match columns of matrix");
+    }
+    T *row = submatrix.data();
+    for (std::size_t i = 0; i < submatrix.n(); ++i, row += submatrix.ld()) {
+        T projection = 0;
+        for (std::size_t j = 0; j < N; ++j) {
+            projection += row[j] * v[j,0];
+        }
+        projection *= T(2);
+        for (std::size_t j = 0; j < N; ++j) {
+            row[j] -= projection * conj(v[j,0]);
+        }
+    }
+}
+
+inline std::atomic<std::size_t>& configured_hessenberg_block_size() {
+    static std::atomic<std::size_t> size = 32;
+    return size;
+}
+
+inline std::size_t hessenberg_block_size() {
+    return configured_hessenberg_block_size().load(std::memory_order_relaxed);
+}
+
+inline void set_hessenberg_block_size(std::size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("block size of Hessenberg reduction can't be 0");
+    }
+    configured_hessenberg_block_size().store(size, std::memory_order_relaxed);
+}
+
+template<typename T>
+void reduce_hessenberg_panel(Matrix<T> &matrix, std::size_t k, std::size_t size, EigenWorkspace<T> &workspace) {
+    std::size_t n = matrix.n();
+    std::size_t m = n - k - 1;
+    Matrix<T> &V = workspace.panel;
+    Matrix<T> &factor = workspace.factor;
+    Matrix<T> &Y = workspace.panel_product;
+    Matrix<T> &column = workspace.column;
+    Matrix<T> &v = workspace.reflector;
+
+    // V and T are filled by columns, their elements above the columns must be zero
+    V.resize(m, size);
+    factor.resize(size, size);
+    Y.resize(n, size);
+    column.resize(n, 1);
+    std::fill(V.data(), V.data() + m * size, T(0));
+    std::fill(factor.data(), factor.data() + size * size, T(0));
+    std::fill(Y.data(), Y.data() + n * size, T(0));
+
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t c = k + i;
+
+        // brings column up to date with previous reflectors of the panel: A - YV* on the right, I - VT*V* on the left
+        column = matrix[Slice(0, n), c];
+        if (i > 0) {
+            column.noalias() -= Y[Slice(0, n), Slice(0, i)] * conj(V[Slice(i-1, i), Slice(0, i)]);
+            auto projection = workspace.coefficients[Slice(0, i), 0];
+            projection.noalias() = conj(V[Slice(0, m), Slice(0, i)]) * column[Slice(k+1, n), 0];
+            auto w = workspace.scaled_coefficients[Slice(0, i), 0];
+            w.noalias() = conj(factor[Slice(0, i), Slice(0, i)]) * projection;
+            column[Slice(k+1, n), 0].noalias() -= V[Slice(0, m), Slice(0, i)] * w;
+        }
+
+        // column which already has zeros below subdiagonal gives empty reflector
+        if (c + 2 < n && norm(column[Slice(c+2, n), 0]) != 0) {
+            v.resize(n - c - 1, 1);
+            v = column[Slice(c+1, n), 0];
+            make_householder_vector(v[Slice(0, v.n()), 0]);
+            T projection = 0;
+            for (std::size_t r = c+1; r < n; ++r) {
+                projection += conj(v[r-c-1, 0]) * column[r, 0];
+            }
+            column[c+1, 0] -= T(2) * v[0, 0] * projection;
+            for (std::size_t r = c+2; r < n; ++r) {
+                column[r, 0] = 0;
+            }
+            V[Slice(i, m), i] = v;
+
+            // Y = AVT is extended by column 2(Av - Y V*v) computed with matrix which isn't updated by the panel yet,
+            // T is extended by column -2 T V*v
+            auto y = Y[Slice(0, n), i];
+            y.noalias() = matrix[Slice(0, n), Slice(c+1, n)] * v;
+            if (i > 0) {
+                auto w = workspace.coefficients[Slice(0, i), 0];
+                w.noalias() = conj(V[Slice(i, m), Slice(0, i)]) * v;
+                y.noalias() -= Y[Slice(0, n), Slice(0, i)] * w;
+                factor[Slice(0, i), i].noalias() = factor[Slice(0, i), Slice(0, i)] * w * T(-2);
+            }
+            y *= T(2);
+            factor[i, i] = 2;
+        }
+        matrix[Slice(0, n), c] = column;
+    }
 }
 
 template<typename T>
-Matrix<T> hessenberg(Matrix<T> &matrix) {
+void reduce_hessenberg(Matrix<T> &matrix, EigenWorkspace<T> &workspace) {
     if (matrix.n() != matrix.m()) {
         throw std::invalid_argument("only square matrices have Hessenberg decomposition");
     }
+    std::size_t n = matrix.n();
+    std::size_t count = (n > 2 ? n - 2 : 0);
+    Matrix<T> &reflectors = workspace.reflectors;
+    reflectors.resize(n, count);
+    std::fill(reflectors.data(), reflectors.data() + n * count, T(0));
 
-    auto Q = identity<T>(matrix.n());
+    // panels of reflectors are accumulated into I - VTV* and applied to the rest of matrix by matrix products
+    std::size_t size = hessenberg_block_size();
+    std::size_t k = 0;
+    if (size > 1 && size + HESSENBERG_CROSSOVER < n) {
+        // products are evaluated by GEMM into one buffer, each element of matrix is subtracted only by itself
+        Matrix<T> &buffer = workspace.update;
+        for (; k + size + HESSENBERG_CROSSOVER < n; k += size) {
+            std::size_t m = n - k - 1;
+            std::size_t rest = n - k - size;
+            reduce_hessenberg_panel(matrix, k, size, workspace);
+            Matrix<T> &V = workspace.panel;
+            reflectors[Slice(k+1, n), Slice(k, k+size)] = V;
+
+            // A - YV* on the right
+            buffer.resize(n, rest);
+            buffer.noalias() = workspace.panel_product * conj(V[Slice(size-1, m), Slice(0, size)]);
+            matrix[Slice(0, n), Slice(k+size, n)].noalias() -= buffer;
+
+            // (I - VT*V*)A on the left
+            Matrix<T> &projection = workspace.projection;
+            Matrix<T> &W = workspace.weights;
+            projection.resize(size, rest);
+            projection.noalias() = conj(V) * matrix[Slice(k+1, n), Slice(k+size, n)];
+            W.resize(size, rest);
+            W.noalias() = conj(workspace.factor) * projection;
+            buffer.resize(m, rest);
+            buffer.noalias() = V * W;
+            matrix[Slice(k+1, n), Slice(k+size, n)].noalias() -= buffer;
+        }
+    }
+
+    Matrix<T> &v = workspace.reflector;
+    for (; k < count; ++k) {
+        // column which already has zeros below subdiagonal doesn't need reflection
+        if (norm(matrix[Slice(k+2, n), k]) == 0) {
+            continue;
+        }
 
-    for (int k = 0; k < matrix.n()-2; ++k) {
         // creates householder vector
-        auto x = matrix[Slice(k+1, matrix.n()), k];
-        auto v = householder_vector(x);
+        v.resize(n - k - 1, 1);
+        v = matrix[Slice(k+1, n), k];
+        make_householder_vector(v[Slice(0, v.n()), 0]);
+        reflectors[Slice(k+1, n), k] = v;
 
         // apply householder transformation to both sides of the matrix in order to reach similarity
-        left_h_transformation(matrix[Slice(k+1, matrix.n()), Slice(k, matrix.n())], v);
+        apply_householder_left(matrix[Slice(k+1, n), Slice(k, n)], v);
+
+        apply_householder_right(matrix[Slice(0, n), Slice(k+1, n)], v);
+    }
+}
+
+// Householder sequence implementation //
+
+template<typename T>
+std::size_t HouseholderSequence<T>::n() const {
+    return reflectors.n();
+}
 
-        right_h_transformation(matrix[Slice(0, matrix.n()), Slice(k+1, matrix.n())], v);
+template<typename T>
+std::size_t HouseholderSequence<T>::m() const {
+    return reflectors.n();
+}
 
-        auto Q_submatrix = Q[Slice(1, matrix.n()), Slice(k+1, matrix.n())];
+template<typename T>
+void HouseholderSequence<T>::factor(std::size_t begin, std::size_t end, EigenWorkspace<T> &workspace) const {
+    std::size_t n = reflectors.n();
+    std::size_t size = end - begin;
 
-        // updates matrix Q of hessenberg decomposition
-        if (k == 0) { Q_submatrix -= T(2) * v * conj(v); }
-        else { right_h_transformation(Q_submatrix, v); }
+    // product of reflectors of block is I - VTV*, T is upper triangular and grows by column -2 T V*v
+    Matrix<T> &result = workspace.factor;
+    result.resize(size, size);
+    std::fill(result.data(), result.data() + size * size, T(0));
+    for (std::size_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            auto w = workspace.coefficients[Slice(0, i), 0];
+            w.noalias() = conj(reflectors[Slice(begin+1, n), Slice(begin, begin+i)]) * reflectors[Slice(begin+1, n), begin+i];
+            result[Slice(0, i), i].noalias() = result[Slice(0, i), Slice(0, i)] * w * T(-2);
+        }
+        result[i, i] = (norm(reflectors[Slice(begin+1, n), begin+i]) != 0 ? 2 : 0);
     }
-    return Q;
 }
 
 template<typename T>
-Matrix<T> givens(T x, T y) {
-    auto result = Matrix<T>(2);
+void HouseholderSequence<T>::apply_block(Matrix<T> &matrix, std::size_t begin, std::size_t end,
+                                         std::size_t first_column, EigenWorkspace<T> &workspace) const {
+    std::size_t n = reflectors.n();
+    std::size_t size = end - begin;
+    std::size_t columns = matrix.m() - first_column;
+    auto V = reflectors[Slice(begin+1, n), Slice(begin, end)];
+    auto rows = matrix[Slice(begin+1, n), Slice(first_column, matrix.m())];
+    factor(begin, end, workspace);
 
-    double abs_x = std::abs(x);
-    double abs_y = std::abs(y);
+    // (I - VTV*)A or (I - VT*V*)A is computed by matrix products
+    Matrix<T> &projection = workspace.projection;
+    Matrix<T> &W = workspace.weights;
+    Matrix<T> &update = workspace.update;
+    projection.resize(size, columns);
+    projection.noalias() = conj(V) * rows;
+    W.resize(size, columns);
+    if (adjoint) {
+        W.noalias() = conj(workspace.factor) * projection;
+    } else {
+        W.noalias() = workspace.factor * projection;
+    }
+    update.resize(n - begin - 1, columns);
+    update.noalias() = V * W;
+    rows.noalias() -= update;
+}
 
-    result[0,0] = x / std::sqrt(abs_x * abs_x + abs_y * abs_y);
-    result[0,1] = conj(-y) / std::sqrt(abs_x * abs_x + abs_y * abs_y);
-    result[1,0] = conj(-result[0,1]);
-    result[1,1] = conj(result[0,0]);
+template<typename T>
+void HouseholderSequence<T>::apply(Matrix<T> &matrix) const {
+    auto workspace = EigenWorkspace<T>();
+    apply(matrix, workspace);
+}
+
+template<typename T>
+void HouseholderSequence<T>::apply(Matrix<T> &matrix, EigenWorkspace<T> &workspace) const {
+    if (matrix.n() != reflectors.n()) {
+        throw std::invalid_argument("householder sequence doesn't match rows of matrix");
+    }
+    std::size_t count = reflectors.m();
+    std::size_t n = reflectors.n();
+
+    // reflectors are applied one by one to small matrices and few columns: factors of compact form cost
+    // about REFLECTOR_BLOCK_SIZE / 2 * n^2 operations whatever count of columns is, one by one costs about 2 * n^2 per column
+    if (n <= REFLECTOR_BLOCK_SIZE || matrix.m() < HOUSEHOLDER_COLUMNS) {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t k = (adjoint ? i : count - 1 - i);
+            if (norm(reflectors[Slice(k+1, n), k]) != 0) {
+                apply_householder_left(matrix[Slice(k+1, n), Slice(0, matrix.m())], reflectors[Slice(k+1, n), k]);
+            }
+        }
+        return;
+    }
+
+    // Q = H_0 H_1 ... is applied from the last block of reflectors, Q* from the first one
+    if (adjoint) {
+        for (std::size_t begin = 0; begin < count; begin += REFLECTOR_BLOCK_SIZE) {
+            apply_block(matrix, begin, std::min(begin + REFLECTOR_BLOCK_SIZE, count), 0, workspace);
+        }
+    } else {
+        for (std::size_t end = count; end > 0;) {
+            std::size_t begin = (end > REFLECTOR_BLOCK_SIZE ? end - REFLECTOR_BLOCK_SIZE : 0);
+            apply_block(matrix, begin, end, 0, workspace);
+            end = begin;
+        }
+    }
+}
+
+template<typename T>
+Matrix<T> HouseholderSequence<T>::materialize() const {
+    auto result = identity<T>(reflectors.n());
+    auto workspace = EigenWorkspace<T>();
+    if (adjoint || reflectors.n() <= REFLECTOR_BLOCK_SIZE) {
+        apply(result, workspace);
+        return result;
+    }
+
+    // while Q is accumulated from the last block, columns before the block are still columns of identity,
+    // so every block touches only trailing rows and columns
+    for (std::size_t end = reflectors.m(); end > 0;) {
+        std::size_t begin = (end > REFLECTOR_BLOCK_SIZE ? end - REFLECTOR_BLOCK_SIZE : 0);
+        apply_block(result, begin, end, begin+1, workspace);
+        end = begin;
+    }
+    return result;
+}
+
+template<typename T>
+HouseholderSequence<T>::HouseholderSequence(const Matrix<T> &reflectors_, bool adjoint_) :
+reflectors(reflectors_), adjoint(adjoint_) {}
+
+template<typename T>
+HouseholderSequence<T>::HouseholderSequence(std::shared_ptr<const Matrix<T>> reflectors_, bool adjoint_) :
+owner(std::move(reflectors_)), reflectors(*owner), adjoint(adjoint_) {}
+
+template<typename T>
+HouseholderSequence<T> conj(const HouseholderSequence<T> &sequence) {
+    HouseholderSequence<T> result = sequence;
+    result.adjoint = !sequence.adjoint;
+    return result;
+}
+
+template<typename T, typename E>
+Matrix<T> operator*(const HouseholderSequence<T> &sequence, const MatrixExpression<T, E> &expression) {
+    Matrix<T> result = expression;
+    sequence.apply(result);
     return result;
 }
 
+// Hessenberg decomposition implementation //
+
+template<typename T>
+const Matrix<T>& HessenbergDecomposition<T>::H() const {
+    return hessenberg_matrix;
+}
+
+template<typename T>
+HouseholderSequence<T> HessenbergDecomposition<T>::Q() const {
+    return HouseholderSequence<T>(reflectors);
+}
+
+template<typename T>
+void HessenbergDecomposition<T>::apply_Q(Matrix<T> &matrix) const {
+    Q().apply(matrix);
+}
+
+template<typename T>
+void HessenbergDecomposition<T>::apply_Qh(Matrix<T> &matrix) const {
+    conj(Q()).apply(matrix);
+}
+
+template<typename T>
+Matrix<T> HessenbergDecomposition<T>::materialize_Q() const {
+    return Q().materialize();
+}
+
+template<typename T>
+HessenbergDecomposition<T>::HessenbergDecomposition(Matrix<T> matrix_) : hessenberg_matrix(std::move(matrix_)) {
+    auto workspace = EigenWorkspace<T>();
+    reduce_hessenberg(hessenberg_matrix, workspace);
+    reflectors = std::make_shared<const Matrix<T>>(std::move(workspace.reflectors));
+}
+
+template<typename T>
+Matrix<T> hessenberg(Matrix<T> &matrix, bool accumulate) {
+    auto decomposition = HessenbergDecomposition<T>(std::move(matrix));
+    matrix = decomposition.H();
+    return (accumulate ? decomposition.materialize_Q() : Matrix<T>());
+}
+
+template<typename T>
+FixedMatrix<T, 2, 2> givens(T x, T y) {
+    // hypot doesn't underflow on tiny elements of converging matrix
+    double r = std::hypot(std::abs(x), std::abs(y));
+    if (r == 0) {
+        return FixedMatrix<T, 2, 2>{T(1), T(0), T(0), T(1)};
+    }
+
+    T c = x / r;
+    T s = conj(-y) / r;
+    return FixedMatrix<T, 2, 2>{c, s, conj(-s), conj(c)};
+}
+
+template<typename T>
+void rotate_rows(Submatrix<T> submatrix, const FixedMatrix<T, 2, 2> &rotation) {
+    if (submatrix.n() != 2) {
+        throw std::invalid_argument("rotation can be applied only to 2 rows");
+    }
+    // rows are walked by pointers, so loop is vectorized
+    T *first = submatrix.data();
+    T *second = first + submatrix.ld();
+    T a = rotation[0, 0], b = rotation[0, 1], c = rotation[1, 0], d = rotation[1, 1];
+    for (std::size_t j = 0; j < submatrix.m(); ++j) {
+        T x = first[j];
+        T y = second[j];
+        first[j] = a * x + b * y;
+        second[j] = c * x + d * y;
+    }
+}
+
+template<typename T>
+void rotate_columns(Submatrix<T> submatrix, const FixedMatrix<T, 2, 2> &rotation) {
+    if (submatrix.m() != 2) {
+        throw std::invalid_argument("rotation can be applied only to 2 columns");
+    }
+    T *row = submatrix.data();
+    T a = rotation[0, 0], b = rotation[0, 1], c = rotation[1, 0], d = rotation[1, 1];
+    for (std::size_t i = 0; i < submatrix.n(); ++i, row += submatrix.ld()) {
+        T x = row[0];
+        T y = row[1];
+        row[0] = x * a + y * c;
+        row[1] = x * b + y * d;
+    }
+}
+
 template<typename T>
 Matrix<T> QR_step(Matrix<T> &matrix) {
     if (matrix.n() != matrix.m()) {
@@ -155,52 +694,264 @@ Matrix<T> QR_step(Matrix<T> &matrix) {
     auto Q = identity<T>(matrix.n());
 
     // performs QR decomposition via multiplying by givens matrix on left
-    auto givenses = std::vector<Matrix<T>>(matrix.n()-1);
+    // k-th rotation is kept only if k-th subdiagonal element wasn't already zero
+    auto givenses = std::vector<FixedMatrix<T, 2, 2>>(matrix.n()-1);
+    auto rotated = std::vector<bool>(matrix.n()-1);
     for (int k = 0; k < matrix.n()-1; ++k) {
         if (std::abs(matrix[k+1, k]) > ZERO) {
             givenses[k] = givens(matrix[k, k], matrix[k + 1, k]);
-            auto submatrix = matrix[Slice(k, k+2), Slice(k, matrix.n())];
-            submatrix = conj(givenses[k]) * submatrix;
+            rotated[k] = true;
+            rotate_rows(matrix[Slice(k, k+2), Slice(k, matrix.n())], conj(givenses[k]));
 
             // updates matrix Q of decomposition
-            auto Q_submatrix = Q[Slice(0, k+2), Slice(k, k + 2)];
-            Q_submatrix = Q_submatrix * givenses[k];
+            rotate_columns(Q[Slice(0, k+2), Slice(k, k + 2)], givenses[k]);
         }
     }
 
     // multiplying the matrix by Q on right
     for (int k = 0; k < matrix.n()-1; ++k) {
-        if (givenses[k].n() != 0) {
-            auto submatrix = matrix[Slice(0,k+2), Slice(k,k+2)];
-            submatrix = submatrix * givenses[k];
+        if (rotated[k]) {
+            rotate_columns(matrix[Slice(0,k+2), Slice(k,k+2)], givenses[k]);
         }
     }
     return Q;
 }
 
 template<typename T>
-Matrix<std::complex<T>> complex_schur(Matrix<std::complex<T>> &matrix) {
-    auto Q = identity<std::complex<T>>(matrix.n());
-    auto id = Q;
-    for (int n = matrix.n(); n >= 2; --n) {
-        do {
-            auto tr = matrix[n-2,n-2] + matrix[n-1,n-1];
-            auto det = matrix[n-2,n-2] * matrix[n-1,n-1] - matrix[n-2,n-1] * matrix[n-1,n-2];
+void shifted_QR_step(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end, T shift) {
+    std::size_t n = matrix.n();
+
+    // rotation of first column of H - shift I creates bulge below subdiagonal which is chased to the bottom
+    T x = matrix[begin,begin] - shift;
+    T y = matrix[begin+1,begin];
+    for (std::size_t k = begin; k + 1 < end; ++k) {
+        if (k > begin) {
+            x = matrix[k,k-1];
+            y = matrix[k+1,k-1];
+        }
+        if (y == T(0)) {
+            continue;
+        }
+
+        auto rotation = givens(x, y);
+        std::size_t first = (k > begin ? k-1 : begin);
+        rotate_rows(matrix[Slice(k, k+2), Slice(first, n)], conj(rotation));
+        rotate_columns(matrix[Slice(0, std::min(k+3, end)), Slice(k, k+2)], rotation);
+        if (Q.n() != 0) {
+            rotate_columns(Q[Slice(0, n), Slice(k, k+2)], rotation);
+        }
+        if (k > begin) {
+            matrix[k+1,k-1] = 0;
+        }
+    }
+}
+
+template<typename T>
+std::size_t active_block_begin(Matrix<T> &matrix, std::size_t end, double matrix_norm) {
+    double epsilon = std::numeric_limits<double>::epsilon();
+
+    // subdiagonal element is negligible relative to its diagonal neighbours, whole matrix is scale of zero diagonal
+    std::size_t begin = end - 1;
+    for (; begin > 0; --begin) {
+        double scale = std::abs(matrix[begin-1,begin-1]) + std::abs(matrix[begin,begin]);
+        if (std::abs(matrix[begin,begin-1]) <= epsilon * (scale != 0 ? scale : matrix_norm)) {
+            matrix[begin,begin-1] = 0;
+            break;
+        }
+    }
+    return begin;
+}
+
+template<typename T>
+std::size_t aggressive_early_deflation(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end,
+                                      EigenWorkspace<T> &workspace) {
+    // Schur decomposition of window shares workspace, it is too small for aggressive early deflation of its own
+    static_assert(AED_WINDOW < AED_THRESHOLD);
+    std::size_t n = matrix.n();
+    std::size_t size = std::min((end - begin) / 2, AED_WINDOW);
+    std::size_t window = end - size;
+    double epsilon = std::numeric_limits<double>::epsilon();
+    double smallest = std::numeric_limits<double>::min() / epsilon;
+
+    // Schur decomposition of trailing window turns its coupling to the rest of matrix into spike V*h e1
+    Matrix<T> &block = workspace.window;
+    Matrix<T> &V = workspace.window_vectors;
+    block.resize(size, size);
+    block = matrix[Slice(window, end), Slice(window, end)];
+    make_identity(V, size);
+    schur(block, V, workspace);
+    T h = matrix[window,window-1];
+    Matrix<T> &spike = workspace.column;
+    spike.resize(size, 1);
+    for (std::size_t i = 0; i < size; ++i) {
+        spike[i,0] = h * conj(V[0,i]);
+    }
+
+    // eigenvalues from the bottom of window with negligible spike elements are deflated
+    std::size_t kept = size;
+    while (kept > 0) {
+        if (kept > 1 && block[kept-1,kept-2] != T(0)) {
+            double scale = std::abs(block[kept-1,kept-1]) + std::sqrt(std::abs(block[kept-1,kept-2]))
+                    * std::sqrt(std::abs(block[kept-2,kept-1]));
+            double bound = std::max(epsilon * scale, smallest);
+            if (std::abs(spike[kept-1,0]) > bound || std::abs(spike[kept-2,0]) > bound) {
+                break;
+            }
+            kept -= 2;
+        } else {
+            if (std::abs(spike[kept-1,0]) > std::max(epsilon * std::abs(block[kept-1,kept-1]), smallest)) {
+                break;
+            }
+            kept -= 1;
+        }
+    }
+    workspace.shifts.resize(kept, kept);
+    if (kept > 0) {
+        workspace.shifts = block[Slice(0, kept), Slice(0, kept)];
+    }
+    if (kept == size) {
+        return 0;
+    }
+
+    // applies V to the window and to the rest of matrix, products go through buffer since they read their targets
+    Matrix<T> &buffer = workspace.update;
+    matrix[Slice(window, end), Slice(window, end)] = block;
+    if (end < n) {
+        buffer.resize(size, n - end);
+        buffer.noalias() = conj(V) * matrix[Slice(window, end), Slice(end, n)];
+        matrix[Slice(window, end), Slice(end, n)] = buffer;
+    }
+    buffer.resize(window, size);
+    buffer.noalias() = matrix[Slice(0, window), Slice(window, end)] * V;
+    matrix[Slice(0, window), Slice(window, end)] = buffer;
+    if (Q.n() != 0) {
+        buffer.resize(n, size);
+        buffer.noalias() = Q[Slice(0, n), Slice(window, end)] * V;
+        Q[Slice(0, n), Slice(window, end)] = buffer;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        matrix[window+i,window-1] = (i < kept ? spike[i,0] : T(0));
+    }
 
-            // computes Wilkinson shift
-            std::complex<T> shift = (tr + std::sqrt(tr * tr - std::complex<T>(4) * det)) / std::complex<T>(2);
+    // returns rows which weren't deflated to hessenberg form: reflection of spike, then reduction of the block
+    if (kept > 1) {
+        std::size_t last = window + kept;
+        Matrix<T> &v = workspace.reflector;
+        if (norm(matrix[Slice(window+1, last), window-1]) != 0) {
+            v.resize(kept, 1);
+            v = matrix[Slice(window, last), window-1];
+            make_householder_vector(v[Slice(0, kept), 0]);
+            apply_householder_left(matrix[Slice(window, last), Slice(window-1, n)], v);
+            apply_householder_right(matrix[Slice(0, last), Slice(window, last)], v);
+            if (Q.n() != 0) {
+                apply_householder_right(Q[Slice(0, n), Slice(window, last)], v);
+            }
+            for (std::size_t i = window+1; i < last; ++i) {
+                matrix[i,window-1] = 0;
+            }
+        }
+
+        // block is reduced apart from the matrix, its reflectors are accumulated into Z which is applied
+        // to the rest of matrix by products
+        Matrix<T> &rest = workspace.window;
+        Matrix<T> &Z = workspace.window_vectors;
+        rest.resize(kept, kept);
+        rest = matrix[Slice(window, last), Slice(window, last)];
+        make_identity(Z, kept);
+        for (std::size_t k = 0; k + 2 < kept; ++k) {
+            if (norm(rest[Slice(k+2, kept), k]) == 0) {
+                continue;
+            }
+            v.resize(kept - k - 1, 1);
+            v = rest[Slice(k+1, kept), k];
+            make_householder_vector(v[Slice(0, v.n()), 0]);
+            apply_householder_left(rest[Slice(k+1, kept), Slice(k, kept)], v);
+            apply_householder_right(rest[Slice(0, kept), Slice(k+1, kept)], v);
+            apply_householder_right(Z[Slice(0, kept), Slice(k+1, kept)], v);
+        }
 
-            // performs QR step with shift on the matrix
-            matrix -= shift * id;
-            Q = Q * QR_step(matrix);
-            matrix += shift * id;
-        } while (std::abs(matrix[n-1, n-2]) > ZERO);
-        // after making element on the left of n-th diagonal element sufficiently small
-        // deflates matrix and chooses different Wilkinson shift
+        matrix[Slice(window, last), Slice(window, last)] = rest;
+        if (last < n) {
+            buffer.resize(kept, n - last);
+            buffer.noalias() = conj(Z) * matrix[Slice(window, last), Slice(last, n)];
+            matrix[Slice(window, last), Slice(last, n)] = buffer;
+        }
+        buffer.resize(window, kept);
+        buffer.noalias() = matrix[Slice(0, window), Slice(window, last)] * Z;
+        matrix[Slice(0, window), Slice(window, last)] = buffer;
+        if (Q.n() != 0) {
+            buffer.resize(n, kept);
+            buffer.noalias() = Q[Slice(0, n), Slice(window, last)] * Z;
+            Q[Slice(0, n), Slice(window, last)] = buffer;
+        }
     }
+    return size - kept;
+}
+
+template<typename T>
+Matrix<std::complex<T>> complex_schur(Matrix<std::complex<T>> &matrix, bool accumulate) {
+    auto Q = (accumulate ? identity<std::complex<T>>(matrix.n()) : Matrix<std::complex<T>>());
+    auto workspace = EigenWorkspace<std::complex<T>>();
+    complex_schur(matrix, Q, workspace);
     return Q;
 }
 
+template<typename T>
+void complex_schur(Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &Q,
+                   EigenWorkspace<std::complex<T>> &workspace) {
+    double matrix_norm = m_norm(matrix);
+
+    std::size_t end = matrix.n();
+    std::size_t iterations = 0;
+    std::size_t total_iterations = 0;
+    while (end > 0) {
+        std::size_t begin = active_block_begin(matrix, end, matrix_norm);
+        if (begin + 1 == end) {
+            // after making element on the left of the last diagonal element sufficiently small
+            // deflates matrix and chooses different Wilkinson shift
+            end -= 1;
+            iterations = 0;
+            continue;
+        }
+
+        if (++total_iterations > MAX_SCHUR_ITERATIONS * std::max<std::size_t>(matrix.n(), 10)) {
+            throw std::runtime_error("Schur decomposition didn't converge");
+        }
+        ++iterations;
+
+        if (end - begin >= AED_THRESHOLD) {
+            // eigenvalues of window which weren't deflated are shifts of following QR steps, starting from the bottom
+            end -= aggressive_early_deflation(matrix, Q, begin, end, workspace);
+            const Matrix<std::complex<T>> &shifts = workspace.shifts;
+            for (std::size_t i = shifts.n(); i-- > shifts.n() / 2;) {
+                shifted_QR_step(matrix, Q, begin, end, shifts[i,i]);
+            }
+            iterations = 0;
+            continue;
+        }
+
+        auto a = matrix[end-2,end-2];
+        auto b = matrix[end-2,end-1];
+        auto c = matrix[end-1,end-2];
+        auto d = matrix[end-1,end-1];
+
+        // computes Wilkinson shift: eigenvalue of trailing 2x2 block closest to its last diagonal element,
+        // exceptional shift breaks cycles of matrices on which it stagnates
+        std::complex<T> shift;
+        if (iterations % 10 == 0) {
+            shift = d + std::complex<T>(0.75 * std::abs(c));
+        } else {
+            auto p = (a - d) / std::complex<T>(2);
+            auto root = std::sqrt(p * p + b * c);
+            auto larger = (std::abs(p + root) >= std::abs(p - root) ? p + root : p - root);
+            shift = (larger != std::complex<T>(0) ? d - b * c / larger : d);
+        }
+
+        // performs implicit QR step with shift on the active block
+        shifted_QR_step(matrix, Q, begin, end, shift);
+    }
+}
+
 template<typename T>
 Matrix<std::complex<T>> schur_eigenvector(Matrix<std::complex<T>> matrix, std::size_t value_index) {
     matrix -= matrix[value_index, value_index] * identity<std::complex<T>>(matrix.n());
@@ -217,81 +968,937 @@ Matrix<std::complex<T>> schur_eigenvector(Matrix<std::complex<T>> matrix, std::s
     return result / std::complex<T>(norm(result));
 }
 
+template<typename T>
+Matrix<std::complex<T>> schur_eigenvectors(const Matrix<std::complex<T>> &matrix) {
+    auto result = Matrix<std::complex<T>>();
+    auto workspace = EigenWorkspace<std::complex<T>>();
+    schur_eigenvectors(matrix, result, workspace);
+    return result;
+}
+
+template<typename T>
+void schur_eigenvectors(const Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &result,
+                        EigenWorkspace<std::complex<T>> &workspace) {
+    std::size_t n = matrix.n();
+    T epsilon = std::numeric_limits<T>::epsilon();
+    T smallest = std::numeric_limits<T>::min() / epsilon;
+    T largest = std::numeric_limits<T>::max() / 2;
+
+    // sum of absolute values of elements of row above diagonal bounds growth of solution
+    std::vector<T> &row_norms = workspace.row_norms;
+    row_norms.assign(n, T(0));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i+1; j < n; ++j) {
+            row_norms[i] += std::abs(matrix[i,j]);
+        }
+    }
+
+    result.resize(n, n);
+    std::fill(result.data(), result.data() + n * n, std::complex<T>(0));
+    std::vector<std::complex<T>> &x = workspace.solution;
+    x.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::complex<T> value = matrix[k,k];
+
+        // diagonal element equal to eigenvalue is replaced by small one in order to get finite solution
+        T threshold = std::max(epsilon * std::abs(value), smallest);
+        auto scale = [&x, k](T factor, std::size_t from) {
+            for (std::size_t j = from; j <= k; ++j) {
+                x[j] *= factor;
+            }
+        };
+
+        // solves triangular system (T - value I)x = 0 from the bottom, x is scaled down whenever
+        // next element or sum of its row could overflow
+        x[k] = 1;
+        T x_max = 1;
+        for (std::size_t i = k; i-- > 0;) {
+            if (x_max > 1 && row_norms[i] > largest / x_max) {
+                scale(1 / x_max, i+1);
+                x_max = 1;
+            }
+            std::complex<T> r = 0;
+            for (std::size_t j = i+1; j <= k; ++j) {
+                r -= matrix[i,j] * x[j];
+            }
+
+            std::complex<T> divisor = matrix[i,i] - value;
+            if (std::abs(divisor) < threshold) {
+                divisor = threshold;
+            }
+            T r_abs = std::abs(r);
+            if (r_abs > 1 && std::abs(divisor) < 1 && r_abs > largest * std::abs(divisor)) {
+                scale(1 / r_abs, i+1);
+                x_max /= r_abs;
+                r /= r_abs;
+            }
+            x[i] = r / divisor;
+            x_max = std::max(x_max, std::abs(x[i]));
+        }
+
+        // the largest element becomes 1, so back-transformation and normalization don't overflow
+        x_max = 0;
+        for (std::size_t i = 0; i <= k; ++i) {
+            x_max = std::max(x_max, std::abs(x[i]));
+        }
+        for (std::size_t i = 0; i <= k; ++i) {
+            result[i,k] = x[i] / x_max;
+        }
+    }
+}
+
+template<typename T>
+std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs_from(std::size_t n, const std::complex<T> *values,
+                                                                                const std::complex<T> *vectors) {
+    auto result = std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>>(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        auto eigenvector = Matrix<std::complex<T>>(n, 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            eigenvector[i,0] = vectors[i * n + k];
+        }
+        result[k] = std::make_pair(values[k], std::move(eigenvector));
+    }
+    return result;
+}
+
+template<typename T>
+void eigenpairs(Matrix<std::complex<T>> &matrix, std::complex<T> *values, std::complex<T> *vectors) {
+    auto workspace = EigenWorkspace<std::complex<T>>();
+    eigenpairs(matrix, values, vectors, workspace);
+}
+
+template<typename T>
+void eigenpairs(Matrix<std::complex<T>> &matrix, std::complex<T> *values, std::complex<T> *vectors,
+                EigenWorkspace<std::complex<T>> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
+
+    // hermitian matrix has real eigenvalues and orthonormal eigenvectors, which are found faster
+    if (is_hermitian(matrix)) {
+        hermitian_eigenpairs(matrix, values, vectors, workspace);
+        return;
+    }
+
+    // eigenvectors of triangular matrix are back-transformed by Z and reflectors of Hessenberg decomposition,
+    // Q isn't formed
+    Matrix<std::complex<T>> &Z = workspace.schur_vectors;
+    Matrix<std::complex<T>> &eigenvectors = workspace.eigenvectors;
+    reduce_hessenberg(matrix, workspace);
+    make_identity(Z, n);
+    complex_schur(matrix, Z, workspace);
+    schur_eigenvectors(matrix, eigenvectors, workspace);
+    workspace.update.resize(n, n);
+    workspace.update.noalias() = Z * eigenvectors;
+    std::swap(workspace.update, eigenvectors);
+    HouseholderSequence<std::complex<T>>(workspace.reflectors).apply(eigenvectors, workspace);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        values[k] = matrix[k,k];
+        std::complex<T> length = norm(eigenvectors[Slice(0, n), k]);
+        for (std::size_t i = 0; i < n; ++i) {
+            vectors[i * n + k] = eigenvectors[i,k] / length;
+        }
+    }
+}
+
 template<typename T>
 std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs(Matrix<std::complex<T>> matrix) {
     if (matrix.n() != matrix.m()) {
         throw std::invalid_argument("only square matrix is allowed");
     }
+    std::size_t n = matrix.n();
+
+    auto values = std::vector<std::complex<T>>(n);
+    auto vectors = Matrix<std::complex<T>>(n, n);
+    eigenpairs(matrix, values.data(), vectors.data());
+    return eigenpairs_from(n, values.data(), vectors.data());
+}
+
+// real Schur decomposition implementation //
+
+template<typename T>
+std::complex<T> block_eigenvalue(const Matrix<T> &matrix, std::size_t k) {
+    T p = (matrix[k,k] - matrix[k+1,k+1]) / 2;
+    T discriminant = p * p + matrix[k,k+1] * matrix[k+1,k];
+    T real = (matrix[k,k] + matrix[k+1,k+1]) / 2;
+    if (discriminant >= 0) {
+        return real + std::sqrt(discriminant);
+    }
+    return std::complex<T>(real, std::sqrt(-discriminant));
+}
 
-    auto Q1 = hessenberg(matrix);
-    auto Q2 = complex_schur(matrix);
+template<typename T>
+void francis_step(Matrix<T> &matrix, Matrix<T> &Q, std::size_t begin, std::size_t end, T s, T t) {
+    std::size_t n = matrix.n();
 
-    auto id = identity<std::complex<T>>(matrix.n());
+    // first column of (H - aI)(H - bI) where a + b = s, ab = t, has only three nonzero elements
+    T x = matrix[begin,begin] * matrix[begin,begin] + matrix[begin,begin+1] * matrix[begin+1,begin]
+            - s * matrix[begin,begin] + t;
+    T y = matrix[begin+1,begin] * (matrix[begin,begin] + matrix[begin+1,begin+1] - s);
+    T z = matrix[begin+1,begin] * matrix[begin+2,begin+1];
 
-    auto result = std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>>(matrix.n());
-    for (int i = 0; i < matrix.n(); ++i) {
-        auto eigenvalue = matrix[i, i];
-        Matrix<std::complex<T>> eigenvector = Q1 * (Q2 * schur_eigenvector(matrix, i));
-        result[i] = (std::make_pair(eigenvalue, eigenvector));
+    // reflector of first column creates bulge below subdiagonal which is chased to the bottom of active block
+    for (std::size_t k = begin; k + 2 < end; ++k) {
+        // reflection of negligible column whose norm underflows is skipped
+        FixedMatrix<T, 3, 1> column{x, y, z};
+        if (norm(column) != 0) {
+            auto v = householder_vector(column);
+            std::size_t first = (k > begin ? k-1 : begin);
+            reflect_rows(matrix[Slice(k, k+3), Slice(first, n)], v);
+            reflect_columns(matrix[Slice(0, std::min(k+4, end)), Slice(k, k+3)], v);
+            if (Q.n() != 0) {
+                reflect_columns(Q[Slice(0, n), Slice(k, k+3)], v);
+            }
+            if (k > begin) {
+                matrix[k+1,k-1] = 0;
+                matrix[k+2,k-1] = 0;
+            }
+        }
+
+        x = matrix[k+1,k];
+        y = matrix[k+2,k];
+        if (k + 3 < end) {
+            z = matrix[k+3,k];
+        }
+    }
+
+    FixedMatrix<T, 2, 1> last_column{x, y};
+    if (norm(last_column) != 0) {
+        auto v = householder_vector(last_column);
+        reflect_rows(matrix[Slice(end-2, end), Slice(end-3, n)], v);
+        reflect_columns(matrix[Slice(0, end), Slice(end-2, end)], v);
+        if (Q.n() != 0) {
+            reflect_columns(Q[Slice(0, n), Slice(end-2, end)], v);
+        }
+        matrix[end-1,end-3] = 0;
     }
+}
+
+template<typename T>
+void split_block(Matrix<T> &matrix, Matrix<T> &Q, std::size_t k) {
+    T p = (matrix[k,k] - matrix[k+1,k+1]) / 2;
+    T discriminant = p * p + matrix[k,k+1] * matrix[k+1,k];
+    if (discriminant < 0) {
+        return;
+    }
+
+    // rotates eigenvector of the block to the first coordinate, both expressions of it are collinear,
+    // the longer one is taken to avoid cancellation
+    T z = p + std::copysign(std::sqrt(discriminant), p);
+    T x1 = matrix[k,k+1];
+    T y1 = z - 2 * p;
+    T x2 = z;
+    T y2 = matrix[k+1,k];
+    if (std::abs(x1) + std::abs(y1) < std::abs(x2) + std::abs(y2)) {
+        x1 = x2;
+        y1 = y2;
+    }
+    if (x1 == 0 && y1 == 0) {
+        return;
+    }
+
+    auto rotation = givens(x1, y1);
+    rotate_rows(matrix[Slice(k, k+2), Slice(k, matrix.n())], conj(rotation));
+    rotate_columns(matrix[Slice(0, k+2), Slice(k, k+2)], rotation);
+    if (Q.n() != 0) {
+        rotate_columns(Q[Slice(0, Q.n()), Slice(k, k+2)], rotation);
+    }
+    matrix[k+1,k] = 0;
+}
+
+template<typename T>
+Matrix<T> real_schur(Matrix<T> &matrix, bool accumulate) {
+    Matrix<T> Q = (accumulate ? identity<T>(matrix.n()) : Matrix<T>());
+    auto workspace = EigenWorkspace<T>();
+    real_schur(matrix, Q, workspace);
+    return Q;
+}
+
+template<typename T>
+void real_schur(Matrix<T> &matrix, Matrix<T> &Q, EigenWorkspace<T> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrices have Schur decomposition");
+    }
+    double matrix_norm = m_norm(matrix);
+
+    std::size_t end = matrix.n();
+    std::size_t iterations = 0;
+    std::size_t total_iterations = 0;
+    while (end > 0) {
+        std::size_t begin = active_block_begin(matrix, end, matrix_norm);
+        if (begin + 1 == end) {
+            end -= 1;
+            iterations = 0;
+            continue;
+        }
+        if (begin + 2 == end) {
+            split_block(matrix, Q, begin);
+            end -= 2;
+            iterations = 0;
+            continue;
+        }
+
+        if (++total_iterations > MAX_SCHUR_ITERATIONS * std::max<std::size_t>(matrix.n(), 10)) {
+            throw std::runtime_error("Schur decomposition didn't converge");
+        }
+        ++iterations;
+
+        if (end - begin >= AED_THRESHOLD) {
+            // pairs of eigenvalues of window which weren't deflated are shifts of following double shift steps,
+            // 2x2 block gives conjugate pair, real eigenvalue is paired with the next one if it is real too
+            end -= aggressive_early_deflation(matrix, Q, begin, end, workspace);
+            const Matrix<T> &shifts = workspace.shifts;
+            for (std::size_t i = shifts.n(); i > shifts.n() / 2;) {
+                T s, t;
+                if (i >= 2 && shifts[i-1,i-2] != 0) {
+                    s = shifts[i-2,i-2] + shifts[i-1,i-1];
+                    t = shifts[i-2,i-2] * shifts[i-1,i-1] - shifts[i-2,i-1] * shifts[i-1,i-2];
+                    i -= 2;
+                } else if (i >= 2 && (i == 2 || shifts[i-2,i-3] == 0)) {
+                    s = shifts[i-2,i-2] + shifts[i-1,i-1];
+                    t = shifts[i-2,i-2] * shifts[i-1,i-1];
+                    i -= 2;
+                } else {
+                    s = 2 * shifts[i-1,i-1];
+                    t = shifts[i-1,i-1] * shifts[i-1,i-1];
+                    i -= 1;
+                }
+                francis_step(matrix, Q, begin, end, s, t);
+            }
+            iterations = 0;
+            continue;
+        }
+
+        // Francis double shift by eigenvalues of trailing 2x2 block,
+        // exceptional shift breaks cycles of matrices on which it stagnates
+        T s, t;
+        if (iterations % 10 == 0) {
+            T w = std::abs(matrix[end-1,end-2]) + std::abs(matrix[end-2,end-3]);
+            s = T(1.5) * w;
+            t = w * w;
+        } else {
+            s = matrix[end-2,end-2] + matrix[end-1,end-1];
+            t = matrix[end-2,end-2] * matrix[end-1,end-1] - matrix[end-2,end-1] * matrix[end-1,end-2];
+        }
+        francis_step(matrix, Q, begin, end, s, t);
+    }
+}
+
+template<typename T>
+Matrix<T> schur(Matrix<T> &matrix, bool accumulate) {
+    return real_schur(matrix, accumulate);
+}
+
+template<typename T>
+Matrix<std::complex<T>> schur(Matrix<std::complex<T>> &matrix, bool accumulate) {
+    return complex_schur(matrix, accumulate);
+}
+
+template<typename T>
+void schur(Matrix<T> &matrix, Matrix<T> &Q, EigenWorkspace<T> &workspace) {
+    real_schur(matrix, Q, workspace);
+}
+
+template<typename T>
+void schur(Matrix<std::complex<T>> &matrix, Matrix<std::complex<T>> &Q, EigenWorkspace<std::complex<T>> &workspace) {
+    complex_schur(matrix, Q, workspace);
+}
+
+template<typename T>
+const Matrix<T>& SchurDecomposition<T>::schur_form() const {
+    return schur_matrix;
+}
+
+template<typename T>
+const HessenbergDecomposition<T>& SchurDecomposition<T>::hessenberg_decomposition() const {
+    return reduction;
+}
+
+template<typename T>
+const Matrix<T>& SchurDecomposition<T>::Z() const {
+    return schur_vectors;
+}
+
+template<typename T>
+void SchurDecomposition<T>::apply_Q(Matrix<T> &matrix) const {
+    Matrix<T> product = schur_vectors * matrix;
+    reduction.apply_Q(product);
+    matrix = std::move(product);
+}
 
+template<typename T>
+void SchurDecomposition<T>::apply_Qh(Matrix<T> &matrix) const {
+    reduction.apply_Qh(matrix);
+    Matrix<T> product = conj(schur_vectors) * matrix;
+    matrix = std::move(product);
+}
+
+template<typename T>
+Matrix<T> SchurDecomposition<T>::materialize_Q() const {
+    Matrix<T> result = schur_vectors;
+    reduction.apply_Q(result);
     return result;
 }
 
-// extra function. Isn't required to find eigenpairs but cost me a lot of time to implement :(
-// decomposes real matrix to QTQ* where T is block-upper triangular and Q is unitary
 template<typename T>
-Matrix<T> real_schur(Matrix<T> &matrix) {
-    Matrix<T> Q = identity<T>(matrix.n());
+SchurDecomposition<T>::SchurDecomposition(Matrix<T> matrix) :
+reduction(std::move(matrix)), schur_matrix(reduction.H()), schur_vectors(schur(schur_matrix)) {}
 
-    std::size_t p = matrix.n();
-    while (p > 2) {
-        int count = 1;
+template<typename T>
+Matrix<T> real_schur_eigenvectors(const Matrix<T> &matrix) {
+    auto result = Matrix<T>();
+    auto workspace = EigenWorkspace<T>();
+    real_schur_eigenvectors(matrix, result, workspace);
+    return result;
+}
 
-        T s = matrix[p-2,p-2] + matrix[p-1,p-1];
-        T t = matrix[p-2,p-2] * matrix[p-1,p-1] - matrix[p-2,p-1] * matrix[p-1,p-2];
+template<typename T>
+void real_schur_eigenvectors(const Matrix<T> &matrix, Matrix<T> &result, EigenWorkspace<T> &workspace) {
+    std::size_t n = matrix.n();
+    T epsilon = std::numeric_limits<T>::epsilon();
+    T smallest = std::numeric_limits<T>::min() / epsilon;
 
-        Matrix<T> column = Matrix<T>(3,1);
-        column[0,0] = matrix[0,0] * matrix[0,0] + matrix[0,1] * matrix[1,0] - s * matrix[0,0] + t;
-        column[1,0] = matrix[1,0] * (matrix[0,0] + matrix[1,1] - s);
-        column[2,0] = matrix[1,0] * matrix[2,1];
+    result.resize(n, n);
+    std::fill(result.data(), result.data() + n * n, T(0));
+    std::vector<std::complex<T>> &x = workspace.solution;
+    x.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        bool pair = (k + 1 < n && matrix[k+1,k] != 0);
+        std::complex<T> value = (pair ? block_eigenvalue(matrix, k) : std::complex<T>(matrix[k,k]));
+        std::size_t size = (pair ? 2 : 1);
 
-        auto v = householder_vector(column);
-        left_h_transformation(matrix[Slice(0,3), Slice(0, matrix.n())],v);
-        std::size_t r = (p > 3 ? 4 : 3);
-        right_h_transformation(matrix[Slice(0,r), Slice(0,3)], v);
+        // diagonal element equal to eigenvalue is replaced by small one in order to get finite solution
+        T threshold = std::max(epsilon * (std::abs(value.real()) + std::abs(value.imag())), smallest);
+        auto safe = [threshold](std::complex<T> divisor) {
+            return (std::abs(divisor) < threshold ? std::complex<T>(threshold) : divisor);
+        };
 
-        right_h_transformation(Q[Slice(0,matrix.n()), Slice(0,3)], v);
+        std::fill(x.begin(), x.end(), std::complex<T>(0));
+        if (pair) {
+            x[k] = matrix[k,k+1];
+            x[k+1] = value - matrix[k,k];
+        } else {
+            x[k] = 1;
+        }
 
-        for (std::size_t k = 0; k < p-3; ++k) {
-            ++count;
+        // solves quasi-triangular system (T - value I)x = 0 from the bottom, 2x2 blocks are solved by Cramer's rule
+        std::size_t last = k + size;
+        for (std::size_t i = k; i-- > 0;) {
+            std::complex<T> r = 0;
+            for (std::size_t j = i+1; j < last; ++j) {
+                r -= matrix[i,j] * x[j];
+            }
 
-            column[0,0] = matrix[k+1,k];
-            column[1,0] = matrix[k+2,k];
-            column[2,0] = matrix[k+3,k];
+            if (i > 0 && matrix[i,i-1] != 0) {
+                std::complex<T> q = 0;
+                for (std::size_t j = i+1; j < last; ++j) {
+                    q -= matrix[i-1,j] * x[j];
+                }
+                std::complex<T> a = matrix[i-1,i-1] - value;
+                std::complex<T> d = matrix[i,i] - value;
+                std::complex<T> det = safe(a * d - matrix[i-1,i] * matrix[i,i-1]);
+                x[i-1] = (q * d - matrix[i-1,i] * r) / det;
+                x[i] = (a * r - matrix[i,i-1] * q) / det;
+                --i;
+            } else {
+                x[i] = r / safe(matrix[i,i] - value);
+            }
+        }
 
-            v = householder_vector(column);
-            left_h_transformation(matrix[Slice(k+1,k+4), Slice(k, matrix.n())], v);
-            r = (k+5 < p ? k+5 : p);
-            right_h_transformation(matrix[Slice(0,r), Slice(k+1,k+4)], v);
+        for (std::size_t i = 0; i < last; ++i) {
+            result[i,k] = x[i].real();
+            if (pair) {
+                result[i,k+1] = x[i].imag();
+            }
+        }
+        k += size - 1;
+    }
+}
+
+template<typename T>
+void eigenpairs(Matrix<T> &matrix, std::complex<T> *values, std::complex<T> *vectors) {
+    auto workspace = EigenWorkspace<T>();
+    eigenpairs(matrix, values, vectors, workspace);
+}
+
+template<typename T>
+void eigenpairs(Matrix<T> &matrix, std::complex<T> *values, std::complex<T> *vectors, EigenWorkspace<T> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
+
+    // symmetric matrix has real eigenvalues and orthonormal eigenvectors, which are found faster
+    if (is_hermitian(matrix)) {
+        hermitian_eigenpairs(matrix, values, vectors, workspace);
+        return;
+    }
+
+    Matrix<T> &Z = workspace.schur_vectors;
+    Matrix<T> &eigenvectors = workspace.eigenvectors;
+    reduce_hessenberg(matrix, workspace);
+    make_identity(Z, n);
+    real_schur(matrix, Z, workspace);
+    real_schur_eigenvectors(matrix, eigenvectors, workspace);
+    workspace.update.resize(n, n);
+    workspace.update.noalias() = Z * eigenvectors;
+    std::swap(workspace.update, eigenvectors);
+    HouseholderSequence<T>(workspace.reflectors).apply(eigenvectors, workspace);
 
-            right_h_transformation(Q[Slice(0,matrix.n()), Slice(k+1,k+4)], v);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (k + 1 < n && matrix[k+1,k] != 0) {
+            // columns k and k+1 hold real and imaginary parts of eigenvector of conjugate pair
+            values[k] = block_eigenvalue(matrix, k);
+            values[k+1] = std::conj(values[k]);
+            T length = std::hypot(norm(eigenvectors[Slice(0, n), k]), norm(eigenvectors[Slice(0, n), k+1]));
+            for (std::size_t i = 0; i < n; ++i) {
+                auto element = std::complex<T>(eigenvectors[i,k], eigenvectors[i,k+1]) / length;
+                vectors[i * n + k] = element;
+                vectors[i * n + k + 1] = std::conj(element);
+            }
+            ++k;
+        } else {
+            values[k] = matrix[k,k];
+            T length = norm(eigenvectors[Slice(0, n), k]);
+            for (std::size_t i = 0; i < n; ++i) {
+                vectors[i * n + k] = eigenvectors[i,k] / length;
+            }
         }
+    }
+}
 
-        ++count;
+template<typename T>
+std::vector<std::pair<std::complex<T>, Matrix<std::complex<T>>>> eigenpairs(Matrix<T> matrix) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
 
-        column = Matrix<T>(2,1);
-        column[0,0] = matrix[p-2,p-3];
-        column[1,0] = matrix[p-1,p-3];
+    auto values = std::vector<std::complex<T>>(n);
+    auto vectors = Matrix<std::complex<T>>(n, n);
+    eigenpairs(matrix, values.data(), vectors.data());
+    return eigenpairs_from(n, values.data(), vectors.data());
+}
 
-        v = householder_vector(column);
-        left_h_transformation(matrix[Slice(p-2,p), Slice(p-3,matrix.n())], v);
-        right_h_transformation(matrix[Slice(0, matrix.n()), Slice(p-2,p)], v);
+// Hermitian eigenproblem implementation //
 
-        right_h_transformation(Q[Slice(0, matrix.n()), Slice(p-2,p)], v);
+template<typename T>
+bool is_hermitian(const Matrix<T> &matrix) {
+    if (matrix.n() != matrix.m()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < matrix.n(); ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            if (matrix[i, j] != conj(matrix[j, i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+Matrix<T> tridiagonal(Matrix<T> &matrix, bool accumulate) {
+    auto workspace = EigenWorkspace<T>();
+    tridiagonal(matrix, workspace);
+    if (!accumulate) {
+        return Matrix<T>();
+    }
 
-        if (std::abs(matrix[p-1,p-2]) < ZERO) { p -= 1; }
-        else if (std::abs(matrix[p-2,p-3]) < ZERO) { p -= 2; }
+    // Q is formed from householder sequence, its columns take phases of the similarity
+    std::size_t n = matrix.n();
+    auto Q = HouseholderSequence<T>(workspace.reflectors).materialize();
+    for (std::size_t k = 1; k < n; ++k) {
+        Q[Slice(0, n), k] *= workspace.phases[k];
     }
     return Q;
-}
\ No newline at end of file
+}
+
+template<typename T>
+void tridiagonal(Matrix<T> &matrix, EigenWorkspace<T> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrices have tridiagonal decomposition");
+    }
+    std::size_t n = matrix.n();
+
+    auto buffer = ScratchBuffer<T>(n);
+    T *p = buffer.data();
+
+    // reflectors are kept as householder sequence
+    std::size_t count = (n > 2 ? n - 2 : 0);
+    Matrix<T> &reflectors = workspace.reflectors;
+    Matrix<T> &v = workspace.reflector;
+    reflectors.resize(n, count);
+    std::fill(reflectors.data(), reflectors.data() + n * count, T(0));
+
+    for (std::size_t k = 0; k < count; ++k) {
+        // column which already has zeros below subdiagonal doesn't need reflection
+        if (norm(matrix[Slice(k+2, n), k]) == 0) {
+            continue;
+        }
+        std::size_t m = n - k - 1;
+        v.resize(m, 1);
+        v = matrix[Slice(k+1, n), k];
+        make_householder_vector(v[Slice(0, m), 0]);
+        reflectors[Slice(k+1, n), k] = v;
+
+        // k-th column is reflected alone, k-th row is its conjugate
+        apply_householder_left(matrix[Slice(k+1, n), Slice(k, k+1)], v);
+        for (std::size_t i = k+2; i < n; ++i) {
+            matrix[i, k] = 0;
+        }
+        for (std::size_t i = k+1; i < n; ++i) {
+            matrix[k, i] = conj(matrix[i, k]);
+        }
+
+        // reflection of trailing block from both sides is rank-2 update A - vw* - wv*,
+        // where p = 2Av and w = p - (v*p)v
+        auto block = matrix[Slice(k+1, n), Slice(k+1, n)];
+        std::fill(p, p + m, T(0));
+        gemv(m, m, StorageView<T>{block.data(), block.ld(), 1, false},
+             StorageView<T>{v.data(), 1, 0, false}, p, 1);
+        T projection = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+            p[i] *= T(2);
+            projection += conj(v[i, 0]) * p[i];
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            p[i] -= projection * v[i, 0];
+        }
+        ger(m, m, T(-1), StorageView<T>{v.data(), 1, 0, false}, StorageView<T>{p, 1, 0, true},
+            block.data(), block.ld());
+        ger(m, m, T(-1), StorageView<T>{p, 1, 0, false}, StorageView<T>{v.data(), 1, 0, true},
+            block.data(), block.ld());
+    }
+
+    // diagonal similarity with phases of subdiagonal elements makes them real and non-negative
+    std::vector<T> &phases = workspace.phases;
+    phases.resize(n);
+    T phase = 1;
+    for (std::size_t k = 0; k < n; ++k) {
+        matrix[k, k] = std::real(matrix[k, k]);
+        phases[k] = phase;
+        if (k + 1 < n) {
+            double length = std::abs(matrix[k+1, k]);
+            if (length != 0) {
+                phase *= matrix[k+1, k] / length;
+            }
+            matrix[k+1, k] = length;
+            matrix[k, k+1] = length;
+        }
+    }
+}
+
+template<typename T>
+void tridiagonal_QR_step(std::vector<T> &diagonal, std::vector<T> &subdiagonal, Matrix<T> &Z,
+                         std::size_t begin, std::size_t end, T shift) {
+    std::size_t n = Z.m();
+
+    // rotation of first column of T - shift I creates bulge next to subdiagonal which is chased to the bottom
+    T x = diagonal[begin] - shift;
+    T y = subdiagonal[begin];
+    T bulge = 0;
+    for (std::size_t k = begin; k + 1 < end; ++k) {
+        if (k > begin) {
+            x = subdiagonal[k-1];
+            y = bulge;
+        }
+        auto rotation = conj(givens(x, y));
+        T c = rotation[0, 0];
+        T s = rotation[0, 1];
+        if (k > begin) {
+            subdiagonal[k-1] = std::hypot(x, y);
+        }
+
+        // 2x2 diagonal block is rotated from both sides, next subdiagonal element produces bulge
+        T a = diagonal[k];
+        T b = subdiagonal[k];
+        T d = diagonal[k+1];
+        diagonal[k] = c * c * a + T(2) * c * s * b + s * s * d;
+        diagonal[k+1] = s * s * a - T(2) * c * s * b + c * c * d;
+        subdiagonal[k] = c * s * (d - a) + (c * c - s * s) * b;
+        if (k + 2 < end) {
+            bulge = s * subdiagonal[k+1];
+            subdiagonal[k+1] *= c;
+        }
+        if (Z.n() != 0) {
+            rotate_rows(Z[Slice(k, k+2), Slice(0, n)], rotation);
+        }
+    }
+}
+
+template<typename T>
+void tridiagonal_QR(std::vector<T> &diagonal, std::vector<T> &subdiagonal, Matrix<T> &Z) {
+    std::size_t n = diagonal.size();
+    if (subdiagonal.size() + 1 != n && !(n == 0 && subdiagonal.empty())) {
+        throw std::invalid_argument("subdiagonal must be one element shorter than diagonal");
+    }
+    double epsilon = std::numeric_limits<double>::epsilon();
+    double matrix_norm = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        matrix_norm = std::max(matrix_norm, std::abs(diagonal[k]) + (k > 0 ? std::abs(subdiagonal[k-1]) : 0) +
+                                            (k + 1 < n ? std::abs(subdiagonal[k]) : 0));
+    }
+
+    std::size_t end = n;
+    std::size_t iterations = 0;
+    while (end > 1) {
+        // subdiagonal element is negligible relative to its diagonal neighbours, whole matrix is scale of zero diagonal
+        std::size_t begin = end - 1;
+        for (; begin > 0; --begin) {
+            double scale = std::abs(diagonal[begin-1]) + std::abs(diagonal[begin]);
+            if (std::abs(subdiagonal[begin-1]) <= epsilon * (scale != 0 ? scale : matrix_norm)) {
+                subdiagonal[begin-1] = 0;
+                break;
+            }
+        }
+        if (begin + 1 == end) {
+            --end;
+            iterations = 0;
+            continue;
+        }
+        if (++iterations > MAX_SCHUR_ITERATIONS) {
+            throw std::runtime_error("tridiagonal QR iterations didn't converge");
+        }
+
+        // Wilkinson shift: eigenvalue of trailing 2x2 block closer to its last diagonal element
+        T delta = (diagonal[end-2] - diagonal[end-1]) / 2;
+        T b = subdiagonal[end-2];
+        T shift = diagonal[end-1] - b * b / (delta + (delta >= 0 ? 1 : -1) * std::hypot(delta, b));
+        tridiagonal_QR_step(diagonal, subdiagonal, Z, begin, end, shift);
+    }
+}
+
+template<typename T>
+Matrix<T> tridiagonal_eigenpairs(std::vector<T> &diagonal, std::vector<T> &subdiagonal, bool accumulate) {
+    // rows of Z are eigenvectors, so rotations of QR steps are applied to contiguous memory
+    std::size_t n = diagonal.size();
+    auto Z = (accumulate ? identity<T>(n) : Matrix<T>());
+    tridiagonal_QR(diagonal, subdiagonal, Z);
+
+    // sorts eigenvalues together with rows of Z
+    if (!accumulate) {
+        std::sort(diagonal.begin(), diagonal.end());
+        return Z;
+    }
+    auto order = std::vector<std::size_t>(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return diagonal[i] < diagonal[j]; });
+    auto sorted = Matrix<T>(n, n);
+    auto values = diagonal;
+    for (std::size_t k = 0; k < n; ++k) {
+        diagonal[k] = values[order[k]];
+        sorted[Slice(k, k+1), Slice(0, n)] = Z[Slice(order[k], order[k]+1), Slice(0, n)];
+    }
+    return sorted;
+}
+
+template<typename T>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>> hermitian_eigenpairs(Matrix<T> matrix) {
+    using R = typename RealPart<T>::type;
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
+
+    auto values = std::vector<R>(n);
+    auto vectors = Matrix<T>(n, n);
+    auto workspace = EigenWorkspace<T>();
+    hermitian_eigenpairs(matrix, values.data(), vectors.data(), workspace);
+
+    auto result = std::vector<std::pair<R, Matrix<T>>>(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        result[k] = std::make_pair(values[k], Matrix<T>(vectors[Slice(0, n), k]));
+    }
+    return result;
+}
+
+template<typename T, typename V, typename U>
+void hermitian_eigenpairs(Matrix<T> &matrix, V *values, U *vectors, EigenWorkspace<T> &workspace) {
+    using R = typename RealPart<T>::type;
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
+
+    tridiagonal(matrix, workspace);
+    std::vector<R> &diagonal = workspace.diagonal;
+    std::vector<R> &subdiagonal = workspace.subdiagonal;
+    diagonal.resize(n);
+    subdiagonal.resize(n > 0 ? n - 1 : 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        diagonal[k] = std::real(matrix[k, k]);
+        if (k + 1 < n) {
+            subdiagonal[k] = std::real(matrix[k+1, k]);
+        }
+    }
+    Matrix<R> &Z = workspace.rotations;
+    make_identity(Z, n);
+    tridiagonal_QR(diagonal, subdiagonal, Z);
+
+    std::vector<std::size_t> &order = workspace.order;
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return diagonal[i] < diagonal[j]; });
+
+    // eigenvectors of matrix are Q_H D Z*, columns of D Z* are taken in ascending order of eigenvalues
+    // and multiplied by reflectors without forming Q_H
+    Matrix<T> &eigenvectors = workspace.eigenvectors;
+    eigenvectors.resize(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = 0; k < n; ++k) {
+            eigenvectors[i, k] = workspace.phases[i] * Z[order[k], i];
+        }
+    }
+    HouseholderSequence<T>(workspace.reflectors).apply(eigenvectors, workspace);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        values[k] = diagonal[order[k]];
+        for (std::size_t i = 0; i < n; ++i) {
+            vectors[i * n + k] = eigenvectors[i, k];
+        }
+    }
+}
+
+// eigenvalues only implementation //
+
+template<typename T>
+void eigenvalues(Matrix<std::complex<T>> &matrix, std::complex<T> *values) {
+    auto workspace = EigenWorkspace<std::complex<T>>();
+    eigenvalues(matrix, values, workspace);
+}
+
+template<typename T>
+void eigenvalues(Matrix<std::complex<T>> &matrix, std::complex<T> *values, EigenWorkspace<std::complex<T>> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    if (is_hermitian(matrix)) {
+        hermitian_eigenvalues(matrix, values, workspace);
+        return;
+    }
+
+    auto none = Matrix<std::complex<T>>();
+    reduce_hessenberg(matrix, workspace);
+    complex_schur(matrix, none, workspace);
+
+    for (std::size_t k = 0; k < matrix.n(); ++k) {
+        values[k] = matrix[k, k];
+    }
+}
+
+template<typename T>
+std::vector<std::complex<T>> eigenvalues(Matrix<std::complex<T>> matrix) {
+    auto result = std::vector<std::complex<T>>(matrix.n());
+    eigenvalues(matrix, result.data());
+    return result;
+}
+
+template<typename T>
+void eigenvalues(Matrix<T> &matrix, std::complex<T> *values) {
+    auto workspace = EigenWorkspace<T>();
+    eigenvalues(matrix, values, workspace);
+}
+
+template<typename T>
+void eigenvalues(Matrix<T> &matrix, std::complex<T> *values, EigenWorkspace<T> &workspace) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    if (is_hermitian(matrix)) {
+        hermitian_eigenvalues(matrix, values, workspace);
+        return;
+    }
+    std::size_t n = matrix.n();
+
+    auto none = Matrix<T>();
+    reduce_hessenberg(matrix, workspace);
+    real_schur(matrix, none, workspace);
+
+    // 2x2 diagonal block holds conjugate pair, value with positive imaginary part goes first
+    for (std::size_t k = 0; k < n; ++k) {
+        if (k + 1 < n && matrix[k+1,k] != 0) {
+            values[k] = block_eigenvalue(matrix, k);
+            values[k+1] = std::conj(values[k]);
+            ++k;
+        } else {
+            values[k] = matrix[k, k];
+        }
+    }
+}
+
+template<typename T>
+std::vector<std::complex<T>> eigenvalues(Matrix<T> matrix) {
+    auto result = std::vector<std::complex<T>>(matrix.n());
+    eigenvalues(matrix, result.data());
+    return result;
+}
+
+template<typename T>
+std::vector<typename RealPart<T>::type> hermitian_eigenvalues(Matrix<T> matrix) {
+    auto result = std::vector<typename RealPart<T>::type>(matrix.n());
+    auto workspace = EigenWorkspace<T>();
+    hermitian_eigenvalues(matrix, result.data(), workspace);
+    return result;
+}
+
+template<typename T, typename V>
+void hermitian_eigenvalues(Matrix<T> &matrix, V *values, EigenWorkspace<T> &workspace) {
+    using R = typename RealPart<T>::type;
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix is allowed");
+    }
+    std::size_t n = matrix.n();
+
+    tridiagonal(matrix, workspace);
+    std::vector<R> &diagonal = workspace.diagonal;
+    std::vector<R> &subdiagonal = workspace.subdiagonal;
+    diagonal.resize(n);
+    subdiagonal.resize(n > 0 ? n - 1 : 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        diagonal[k] = std::real(matrix[k, k]);
+        if (k + 1 < n) {
+            subdiagonal[k] = std::real(matrix[k+1, k]);
+        }
+    }
+    auto none = Matrix<R>();
+    tridiagonal_QR(diagonal, subdiagonal, none);
+    std::sort(diagonal.begin(), diagonal.end());
+    std::copy(diagonal.begin(), diagonal.end(), values);
+}
+
+// batched eigen solver implementation //
+
+template<typename T>
+void batched_eigenpairs(std::size_t count, std::size_t n, const T *matrices,
+                        std::complex<typename RealPart<T>::type> *values,
+                        std::complex<typename RealPart<T>::type> *vectors) {
+    // about 25n^3 operations per matrix
+    std::size_t work = count * std::max<std::size_t>(25 * n * n * n, 1);
+    parallel_rows(count, work, [&](std::size_t begin, std::size_t end) {
+        // matrix and workspace of thread are reused by all its problems, so they don't allocate memory
+        auto matrix = Matrix<T>(n, n);
+        auto workspace = EigenWorkspace<T>(n);
+        for (std::size_t b = begin; b < end; ++b) {
+            std::copy(matrices + b * n * n, matrices + (b + 1) * n * n, matrix.data());
+            eigenpairs(matrix, values + b * n, vectors + b * n * n, workspace);
+        }
+    });
+}
+
+template<typename T>
+void batched_eigenvalues(std::size_t count, std::size_t n, const T *matrices,
+                         std::complex<typename RealPart<T>::type> *values) {
+    // about 10n^3 operations per matrix
+    std::size_t work = count * std::max<std::size_t>(10 * n * n * n, 1);
+    parallel_rows(count, work, [&](std::size_t begin, std::size_t end) {
+        auto matrix = Matrix<T>(n, n);
+        auto workspace = EigenWorkspace<T>(n);
+        for (std::size_t b = begin; b < end; ++b) {
+            std::copy(matrices + b * n * n, matrices + (b + 1) * n * n, matrix.data());
+            eigenvalues(matrix, values + b * n, workspace);
+        }
+    });
+}
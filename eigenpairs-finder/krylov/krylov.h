@@ -0,0 +1,85 @@
+#ifndef MATRIX_CALCULATOR_KRYLOV_H
+#define MATRIX_CALCULATOR_KRYLOV_H
+
+#include <complex>
+#include <stdexcept>
+#include <vector>
+#include "../eigenpairs-finder.h"
+
+// part of spectrum searched by Krylov solvers
+enum class Spectrum {
+    largest_magnitude,  // eigenvalues of the largest absolute value
+    largest_real,       // eigenvalues of the largest real part
+    smallest_real       // eigenvalues of the smallest real part
+};
+
+// parameters of Krylov solvers
+struct KrylovOptions {
+    // number of wanted eigenpairs and part of spectrum they are taken from
+    std::size_t count = 6;
+    Spectrum target = Spectrum::largest_magnitude;
+
+    // eigenpair is converged when norm of residual Ax - λx of unit x is below tolerance * |λ|
+    double tolerance = 1e-10;
+
+    // count of restarts after which std::runtime_error is thrown
+    std::size_t max_restarts = 1000;
+
+    // dimension of Krylov subspace, 0 chooses max(2 * count + 1, 20). Operator of size not larger than subspace
+    // is formed as dense matrix and solved directly
+    std::size_t subspace = 0;
+};
+
+// returns true if eigenvalue "first" is wanted more than "second" for "target"
+template<typename T>
+bool is_more_wanted(std::complex<T> first, std::complex<T> second, Spectrum target);
+
+// returns deterministic pseudo-random vector of size n, different for different "seed"
+template<typename T>
+Matrix<T> krylov_start_vector(std::size_t n, std::size_t seed);
+
+// extends Krylov decomposition AV = VH from "begin" to "end" columns of n x (m+1) basis V, H is (m+1) x m matrix
+// of projections. "multiply" computes y = Ax for n x 1 x. New vectors are orthogonalized by classical Gram-Schmidt
+// twice, exhausted Krylov space is extended by vector orthogonal to basis
+template<typename T, typename F>
+void krylov_expand(Matrix<T> &V, Matrix<T> &H, std::size_t begin, std::size_t end, const F &multiply);
+
+// moves diagonal element of triangular matrix from row "from" to row "to" < "from" by swaps of neighbours,
+// accumulates unitary transformation into Q
+template<typename T>
+void move_schur_eigenvalue(Matrix<T> &matrix, Matrix<T> &Q, std::size_t from, std::size_t to);
+
+// returns dimension of Krylov subspace for operator of size n, throws std::invalid_argument for impossible sizes
+std::size_t krylov_subspace_size(std::size_t n, const KrylovOptions &options);
+
+// returns n x n operator as dense matrix built from its products with columns of identity
+template<typename T, typename F>
+Matrix<T> dense_operator(std::size_t n, const F &multiply);
+
+// implicitly restarted Arnoldi solver in Krylov-Schur form: returns options.count eigenpairs of n x n operator,
+// which only multiplies vectors: multiply(x, y) computes y = Ax for n x 1 x. Projected matrix is solved by
+// Hessenberg and Schur decompositions, eigenpairs are ordered from the most wanted one.
+// T - type of elements of operator
+template<typename T, typename F>
+std::vector<std::pair<std::complex<typename RealPart<T>::type>, Matrix<std::complex<typename RealPart<T>::type>>>>
+arnoldi_eigenpairs(std::size_t n, const F &multiply, const KrylovOptions &options = KrylovOptions());
+
+// Arnoldi solver for square matrix or lazy expression, which is only multiplied by vectors
+template<typename T, typename E>
+std::vector<std::pair<std::complex<typename RealPart<T>::type>, Matrix<std::complex<typename RealPart<T>::type>>>>
+arnoldi_eigenpairs(const MatrixExpression<T, E> &matrix, const KrylovOptions &options = KrylovOptions());
+
+// thick restarted Lanczos solver for hermitian operator: returns options.count eigenpairs with real eigenvalues
+// and orthonormal eigenvectors, ordered from the most wanted one. multiply(x, y) computes y = Ax for n x 1 x
+template<typename T, typename F>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>>
+lanczos_eigenpairs(std::size_t n, const F &multiply, const KrylovOptions &options = KrylovOptions());
+
+// Lanczos solver for hermitian matrix or lazy expression, which is only multiplied by vectors
+template<typename T, typename E>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>>
+lanczos_eigenpairs(const MatrixExpression<T, E> &matrix, const KrylovOptions &options = KrylovOptions());
+
+#include "krylov.tpp"
+
+#endif //MATRIX_CALCULATOR_KRYLOV_H
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+template<typename T>
+bool is_more_wanted(std::complex<T> first, std::complex<T> second, Spectrum target) {
+    switch (target) {
+        case Spectrum::largest_magnitude:
+            return std::abs(first) > std::abs(second);
+        case Spectrum::largest_real:
+            return first.real() > second.real();
+        case Spectrum::smallest_real:
+            return first.real() < second.real();
+    }
+    return false;
+}
+
+template<typename T>
+Matrix<T> krylov_start_vector(std::size_t n, std::size_t seed) {
+    auto vector = Matrix<T>(n, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        vector[i, 0] = T(std::sin(12.9898 * double(i + 1) + 78.233 * double(seed + 1)));
+    }
+    return vector;
+}
+
+template<typename T, typename F>
+void krylov_expand(Matrix<T> &V, Matrix<T> &H, std::size_t begin, std::size_t end, const F &multiply) {
+    std::size_t n = V.n();
+    auto x = Matrix<T>(n, 1);
+    auto y = Matrix<T>(n, 1);
+
+    for (std::size_t j = begin; j < end; ++j) {
+        x = V[Slice(0, n), j];
+        multiply(x, y);
+
+        // the second pass removes components that cancellation left after the first one
+        auto basis = V[Slice(0, n), Slice(0, j+1)];
+        Matrix<T> w = y;
+        Matrix<T> h = conj(basis) * w;
+        Matrix<T> correction = basis * h;
+        w -= correction;
+        Matrix<T> h_again = conj(basis) * w;
+        correction = basis * h_again;
+        w -= correction;
+        h += h_again;
+        H[Slice(0, j+1), j] = h;
+
+        double beta = norm(w);
+        if (beta <= 100 * std::numeric_limits<double>::epsilon() * norm(y)) {
+            // basis spans invariant subspace, any orthogonal vector continues the decomposition
+            beta = 0;
+            for (std::size_t seed = j + 1; beta == 0; ++seed) {
+                w = krylov_start_vector<T>(n, seed);
+                for (int pass = 0; pass < 2; ++pass) {
+                    Matrix<T> projection = conj(basis) * w;
+                    correction = basis * projection;
+                    w -= correction;
+                }
+                beta = norm(w);
+            }
+            H[j+1, j] = T(0);
+        } else {
+            H[j+1, j] = T(beta);
+        }
+        V[Slice(0, n), j+1] = w / T(beta);
+    }
+}
+
+template<typename T>
+void move_schur_eigenvalue(Matrix<T> &matrix, Matrix<T> &Q, std::size_t from, std::size_t to) {
+    std::size_t n = matrix.n();
+    for (std::size_t k = from; k-- > to;) {
+        T first = matrix[k, k];
+        T second = matrix[k+1, k+1];
+        if (first == second) {
+            continue;
+        }
+
+        // first column of rotation is eigenvector of 2 x 2 block for its second eigenvalue, so rotation swaps them
+        auto rotation = givens(matrix[k, k+1], second - first);
+        rotate_rows(matrix[Slice(k, k+2), Slice(k, n)], conj(rotation));
+        rotate_columns(matrix[Slice(0, k+2), Slice(k, k+2)], rotation);
+        rotate_columns(Q[Slice(0, Q.n()), Slice(k, k+2)], rotation);
+        matrix[k, k] = second;
+        matrix[k+1, k+1] = first;
+        matrix[k+1, k] = T(0);
+    }
+}
+
+inline std::size_t krylov_subspace_size(std::size_t n, const KrylovOptions &options) {
+    if (options.count == 0 || options.count > n) {
+        throw std::invalid_argument("count of wanted eigenpairs must be between 1 and size of operator");
+    }
+
+    std::size_t m = (options.subspace != 0 ? options.subspace : std::max<std::size_t>(2 * options.count + 1, 20));
+    if (m <= options.count && m < n) {
+        throw std::invalid_argument("Krylov subspace must be larger than count of wanted eigenpairs");
+    }
+    return std::min(m, n);
+}
+
+template<typename T, typename F>
+Matrix<T> dense_operator(std::size_t n, const F &multiply) {
+    auto dense = Matrix<T>(n, n);
+    auto x = Matrix<T>(n, 1);
+    auto y = Matrix<T>(n, 1);
+    for (std::size_t j = 0; j < n; ++j) {
+        x[j, 0] = T(1);
+        multiply(x, y);
+        dense[Slice(0, n), j] = y;
+        x[j, 0] = T(0);
+    }
+    return dense;
+}
+
+template<typename T, typename F>
+std::vector<std::pair<std::complex<typename RealPart<T>::type>, Matrix<std::complex<typename RealPart<T>::type>>>>
+arnoldi_eigenpairs(std::size_t n, const F &multiply, const KrylovOptions &options) {
+    using R = typename RealPart<T>::type;
+    using C = std::complex<R>;
+    std::size_t k = options.count;
+    std::size_t m = krylov_subspace_size(n, options);
+
+    if (m == n) {
+        // subspace spans the whole space, so dense problem is not larger than projected one
+        auto result = eigenpairs(dense_operator<T>(n, multiply));
+        std::stable_sort(result.begin(), result.end(), [&options](const auto &first, const auto &second) {
+            return is_more_wanted(first.first, second.first, options.target);
+        });
+        result.resize(k);
+        return result;
+    }
+
+    // basis is complex, so real operator is applied to its real and imaginary parts
+    auto complex_multiply = [&multiply, n](const Matrix<C> &x, Matrix<C> &y) {
+        if constexpr (std::is_same_v<T, C>) {
+            multiply(x, y);
+        } else {
+            auto real = Matrix<T>(n, 1);
+            auto imaginary = Matrix<T>(n, 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                real[i, 0] = x[i, 0].real();
+                imaginary[i, 0] = x[i, 0].imag();
+            }
+            auto real_product = Matrix<T>(n, 1);
+            auto imaginary_product = Matrix<T>(n, 1);
+            multiply(real, real_product);
+            multiply(imaginary, imaginary_product);
+            for (std::size_t i = 0; i < n; ++i) {
+                y[i, 0] = C(real_product[i, 0], imaginary_product[i, 0]);
+            }
+        }
+    };
+
+    auto V = Matrix<C>(n, m + 1);
+    auto H = Matrix<C>(m + 1, m);
+    Matrix<C> start = krylov_start_vector<C>(n, 0);
+    V[Slice(0, n), 0] = start / C(norm(start));
+
+    // decomposition AV = VH keeps the leading "kept" columns of V after restart
+    std::size_t kept = 0;
+    for (std::size_t restart = 0; restart <= options.max_restarts; ++restart) {
+        krylov_expand(V, H, kept, m, complex_multiply);
+        double scale = std::max(m_norm(H), std::numeric_limits<double>::min());
+
+        // Schur form of projected matrix with the wanted Ritz values leading, restart keeps more of them than
+        // requested, which speeds up convergence when the wanted eigenvalues are poorly separated
+        std::size_t next_kept = (k + m) / 2;
+        auto decomposition = SchurDecomposition<C>(H[Slice(0, m), Slice(0, m)]);
+        Matrix<C> schur_form = decomposition.schur_form();
+        Matrix<C> Q = decomposition.materialize_Q();
+        for (std::size_t i = 0; i < next_kept; ++i) {
+            std::size_t best = i;
+            for (std::size_t j = i + 1; j < m; ++j) {
+                if (is_more_wanted(schur_form[j, j], schur_form[best, best], options.target)) {
+                    best = j;
+                }
+            }
+            move_schur_eigenvalue(schur_form, Q, best, i);
+        }
+
+        // A(VQ) = (VQ)S + v s^T, where spike s is the last row of Q scaled by the last subdiagonal element of H
+        auto spike = std::vector<C>(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            spike[i] = H[m, m-1] * Q[m-1, i];
+        }
+
+        // residual of Ritz pair with eigenvector x of the leading block of S is |s^T x| / |x|
+        Matrix<C> X = schur_eigenvectors(Matrix<C>(schur_form[Slice(0, k), Slice(0, k)]));
+        bool converged = true;
+        for (std::size_t j = 0; j < k && converged; ++j) {
+            C residual = 0;
+            for (std::size_t i = 0; i <= j; ++i) {
+                residual += spike[i] * X[i, j];
+            }
+            double bound = options.tolerance * std::max(std::abs(schur_form[j, j]),
+                                                        std::numeric_limits<double>::epsilon() * scale);
+            converged = std::abs(residual) <= bound * norm(X[Slice(0, k), j]);
+        }
+
+        if (converged) {
+            Matrix<C> coefficients = Q[Slice(0, m), Slice(0, k)] * X;
+            Matrix<C> vectors = V[Slice(0, n), Slice(0, m)] * coefficients;
+            auto result = std::vector<std::pair<C, Matrix<C>>>();
+            for (std::size_t j = 0; j < k; ++j) {
+                Matrix<C> vector = vectors[Slice(0, n), j];
+                result.emplace_back(schur_form[j, j], vector / C(norm(vector)));
+            }
+            return result;
+        }
+
+        // restart keeps the leading Schur vectors and the last basis vector
+        kept = next_kept;
+        Matrix<C> basis = V[Slice(0, n), Slice(0, m)] * Q[Slice(0, m), Slice(0, kept)];
+        V[Slice(0, n), Slice(0, kept)] = basis;
+        Matrix<C> last = V[Slice(0, n), m];
+        V[Slice(0, n), kept] = last;
+        H = Matrix<C>(m + 1, m);
+        H[Slice(0, kept), Slice(0, kept)] = schur_form[Slice(0, kept), Slice(0, kept)];
+        for (std::size_t i = 0; i < kept; ++i) {
+            H[kept, i] = spike[i];
+        }
+    }
+    throw std::runtime_error("Arnoldi iterations didn't converge");
+}
+
+template<typename T, typename E>
+std::vector<std::pair<std::complex<typename RealPart<T>::type>, Matrix<std::complex<typename RealPart<T>::type>>>>
+arnoldi_eigenpairs(const MatrixExpression<T, E> &matrix, const KrylovOptions &options) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix has eigenpairs");
+    }
+    return arnoldi_eigenpairs<T>(matrix.n(), [&matrix](const Matrix<T> &x, Matrix<T> &y) {
+        y = matrix * x;
+    }, options);
+}
+
+template<typename T, typename F>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>>
+lanczos_eigenpairs(std::size_t n, const F &multiply, const KrylovOptions &options) {
+    using R = typename RealPart<T>::type;
+    std::size_t k = options.count;
+    std::size_t m = krylov_subspace_size(n, options);
+    auto wanted = [&options](R first, R second) {
+        return is_more_wanted(std::complex<R>(first), std::complex<R>(second), options.target);
+    };
+
+    if (m == n) {
+        auto result = hermitian_eigenpairs(dense_operator<T>(n, multiply));
+        std::stable_sort(result.begin(), result.end(), [&wanted](const auto &first, const auto &second) {
+            return wanted(first.first, second.first);
+        });
+        result.resize(k);
+        return result;
+    }
+
+    auto V = Matrix<T>(n, m + 1);
+    auto H = Matrix<T>(m + 1, m);
+    Matrix<T> start = krylov_start_vector<T>(n, 0);
+    V[Slice(0, n), 0] = start / T(norm(start));
+
+    std::size_t kept = 0;
+    for (std::size_t restart = 0; restart <= options.max_restarts; ++restart) {
+        krylov_expand(V, H, kept, m, multiply);
+        double scale = std::max(m_norm(H), std::numeric_limits<double>::min());
+
+        // projected matrix is hermitian up to rounding, its eigenpairs are ordered from the most wanted one
+        Matrix<T> projected = H[Slice(0, m), Slice(0, m)];
+        Matrix<T> symmetric = (projected + conj(projected)) * T(0.5);
+        auto pairs = hermitian_eigenpairs(std::move(symmetric));
+        std::stable_sort(pairs.begin(), pairs.end(), [&wanted](const auto &first, const auto &second) {
+            return wanted(first.first, second.first);
+        });
+        auto Y = Matrix<T>(m, m);
+        for (std::size_t j = 0; j < m; ++j) {
+            Y[Slice(0, m), j] = pairs[j].second;
+        }
+
+        // A(VY) = (VY)Θ + v s^T, residual of unit Ritz vector j is |s_j|
+        auto spike = std::vector<T>(m);
+        bool converged = true;
+        for (std::size_t i = 0; i < m; ++i) {
+            spike[i] = H[m, m-1] * Y[m-1, i];
+            if (i < k) {
+                double bound = options.tolerance * std::max(double(std::abs(pairs[i].first)),
+                                                            std::numeric_limits<double>::epsilon() * scale);
+                converged = converged && std::abs(spike[i]) <= bound;
+            }
+        }
+
+        if (converged) {
+            Matrix<T> vectors = V[Slice(0, n), Slice(0, m)] * Y[Slice(0, m), Slice(0, k)];
+            auto result = std::vector<std::pair<R, Matrix<T>>>();
+            for (std::size_t j = 0; j < k; ++j) {
+                result.emplace_back(pairs[j].first, Matrix<T>(vectors[Slice(0, n), j]));
+            }
+            return result;
+        }
+
+        // thick restart keeps more of the wanted Ritz vectors than requested, which speeds up convergence when
+        // the wanted eigenvalues are poorly separated. Projected matrix becomes diagonal with spike below it
+        kept = (k + m) / 2;
+        Matrix<T> basis = V[Slice(0, n), Slice(0, m)] * Y[Slice(0, m), Slice(0, kept)];
+        V[Slice(0, n), Slice(0, kept)] = basis;
+        Matrix<T> last = V[Slice(0, n), m];
+        V[Slice(0, n), kept] = last;
+        H = Matrix<T>(m + 1, m);
+        for (std::size_t i = 0; i < kept; ++i) {
+            H[i, i] = T(pairs[i].first);
+            H[kept, i] = spike[i];
+        }
+    }
+    throw std::runtime_error("Lanczos iterations didn't converge");
+}
+
+template<typename T, typename E>
+std::vector<std::pair<typename RealPart<T>::type, Matrix<T>>>
+lanczos_eigenpairs(const MatrixExpression<T, E> &matrix, const KrylovOptions &options) {
+    if (matrix.n() != matrix.m()) {
+        throw std::invalid_argument("only square matrix has eigenpairs");
+    }
+    return lanczos_eigenpairs<T>(matrix.n(), [&matrix](const Matrix<T> &x, Matrix<T> &y) {
+        y = matrix * x;
+    }, options);
+}
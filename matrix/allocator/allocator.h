@@ -0,0 +1,39 @@
+#ifndef MATRIX_CALCULATOR_ALLOCATOR_H
+#define MATRIX_CALCULATOR_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+// alignment of matrix buffers, enough for the widest SIMD register (AVX-512) and a cache line
+constexpr std::size_t MATRIX_ALIGNMENT = 64;
+
+// allocator which returns memory aligned to "Alignment" bytes
+// T - type of allocated elements
+template<typename T, std::size_t Alignment = MATRIX_ALIGNMENT>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    // allocates uninitialized storage for "count" elements
+    T* allocate(std::size_t count);
+
+    // releases storage obtained from allocate
+    void deallocate(T *pointer, std::size_t count);
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &other);
+};
+
+template<typename T1, typename T2, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T1, Alignment> &first, const AlignedAllocator<T2, Alignment> &second);
+
+#include "allocator.tpp"
+
+#endif //MATRIX_CALCULATOR_ALLOCATOR_H
@@ -0,0 +1,21 @@
+// AlignedAllocator implementation //
+
+template<typename T, std::size_t Alignment>
+T* AlignedAllocator<T, Alignment>::allocate(std::size_t count) {
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+}
+
+template<typename T, std::size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate(T *pointer, std::size_t count) {
+    // size is passed to allocator of the runtime, so it doesn't have to look it up
+    ::operator delete(pointer, count * sizeof(T), std::align_val_t(Alignment));
+}
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+AlignedAllocator<T, Alignment>::AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+template<typename T1, typename T2, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T1, Alignment>&, const AlignedAllocator<T2, Alignment>&) {
+    return true;
+}
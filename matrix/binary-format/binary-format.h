@@ -0,0 +1,151 @@
+#ifndef MATRIX_CALCULATOR_BINARY_FORMAT_H
+#define MATRIX_CALCULATOR_BINARY_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <complex>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../matrix.h"
+#include "../file-mapping/file-mapping.h"
+
+// binary matrix file: 64-byte header, zero padding up to "offset", then elements of matrix as they lie in memory.
+// Numbers of header are written in byte order of the machine, "byte_order" tells it apart when file is read
+// on another machine
+
+// type of elements stored in file
+enum class ElementType : std::uint32_t {
+    float32 = 1,
+    float64 = 2,
+    complex64 = 3,
+    complex128 = 4
+};
+
+// order of elements in file: row by row or column by column
+enum class Layout : std::uint32_t {
+    row_major = 0,
+    column_major = 1
+};
+
+// header of binary matrix file
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order; // "byte_order_mark" written in byte order of writer
+    std::uint32_t element_type;
+    std::uint32_t layout;
+    std::uint64_t rows;
+    std::uint64_t columns;
+    std::uint64_t ld; // distance in elements between starts of consecutive rows (columns for column-major files)
+    std::uint64_t alignment; // payload is aligned to "alignment" bytes from start of file
+    std::uint64_t offset; // position of the first element from start of file
+
+    static constexpr char signature[8] = {'M', 'A', 'T', 'R', 'I', 'X', '\0', '\1'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t byte_order_mark = 0x01020304;
+};
+
+// BinaryElement<T>::type is code of elements of type T, the rest of types can't be stored in binary files
+template<typename T>
+struct BinaryElement;
+
+template<>
+struct BinaryElement<float> {
+    static constexpr ElementType type = ElementType::float32;
+};
+
+template<>
+struct BinaryElement<double> {
+    static constexpr ElementType type = ElementType::float64;
+};
+
+template<>
+struct BinaryElement<std::complex<float>> {
+    static constexpr ElementType type = ElementType::complex64;
+};
+
+template<>
+struct BinaryElement<std::complex<double>> {
+    static constexpr ElementType type = ElementType::complex128;
+};
+
+// returns header of matrix "n" x "m" with elements of type T stored contiguously with "layout",
+// payload is aligned to "alignment" bytes which must be a power of two
+template<typename T>
+BinaryHeader binary_header(std::size_t n, std::size_t m, Layout layout, std::size_t alignment);
+
+// throws std::invalid_argument if "header" isn't a valid header of file with elements of type T,
+// "file_bytes" - size of file, if it is known
+template<typename T>
+void check_binary_header(const BinaryHeader &header, std::uint64_t file_bytes = UINT64_MAX);
+
+// reads header of binary file
+BinaryHeader read_binary_header(std::istream &istream);
+
+// writes matrix obtained by evaluating "expression" into binary stream or file,
+// rows of expressions which lie in memory are written as they are, the rest are evaluated row by row
+template<typename T, typename E>
+void write_binary(std::ostream &ostream, const MatrixExpression<T, E> &expression,
+                  Layout layout = Layout::row_major, std::size_t alignment = MATRIX_ALIGNMENT);
+
+template<typename T, typename E>
+void write_binary(const std::string &path, const MatrixExpression<T, E> &expression,
+                  Layout layout = Layout::row_major, std::size_t alignment = MATRIX_ALIGNMENT);
+
+// returns row-major matrix with elements of payload at "data" described by "header"
+template<typename T>
+Matrix<T> load_binary_payload(const BinaryHeader &header, const T *data);
+
+// reads matrix from binary stream, payload is read straight into memory of the matrix.
+// Size of seekable stream is checked against header before matrix is allocated, other streams are read by chunks
+template<typename T>
+Matrix<T> read_binary(std::istream &istream);
+
+// reads matrix from binary file through memory mapping
+template<typename T>
+Matrix<T> read_binary(const std::string &path);
+
+// binary matrix file mapped into memory, its elements are used without copy.
+// Pages are read from disk when they are touched, so only the used part of file takes memory
+// T - type of elements of matrix
+template<typename T>
+class MappedMatrix {
+private:
+    FileMapping mapping;
+    BinaryHeader header;
+    MapMode mode;
+
+public:
+    // return size of matrix
+    std::size_t n() const;
+    std::size_t m() const;
+
+    // return pointer to the first element and distance between starts of consecutive rows (columns)
+    const T* data() const;
+    std::size_t ld() const;
+
+    // returns layout of elements in file
+    Layout layout() const;
+
+    // returns view of the whole matrix, throws std::invalid_argument for column-major files
+    ConstSubmatrix<T> view() const;
+
+    // returns view of submatrix, throws std::invalid_argument for column-major files
+    ConstSubmatrix<T> operator[](Slice n_slice, Slice m_slice) const;
+
+    // returns changeable view of copy-on-write mapping, throws std::invalid_argument for read-only
+    // mappings and column-major files
+    Submatrix<T> mutable_view();
+
+    // returns copy of matrix, column-major files are transposed into row-major matrix
+    Matrix<T> load() const;
+
+    // throws std::invalid_argument if file isn't a binary matrix file with elements of type T
+    explicit MappedMatrix(const std::string &path, MapMode mode = MapMode::read_only);
+};
+
+#include "binary-format.tpp"
+
+#endif //MATRIX_CALCULATOR_BINARY_FORMAT_H
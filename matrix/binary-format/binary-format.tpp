@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// binary header implementation //
+
+static_assert(sizeof(BinaryHeader) == 64, "header of binary matrix file must occupy 64 bytes");
+
+template<typename T>
+BinaryHeader binary_header(std::size_t n, std::size_t m, Layout layout, std::size_t alignment) {
+    if (alignment < alignof(T) || (alignment & (alignment - 1)) != 0) {
+        throw std::invalid_argument("alignment of binary matrix file must be a power of two not less than alignment of elements");
+    }
+
+    BinaryHeader header{};
+    std::copy(std::begin(BinaryHeader::signature), std::end(BinaryHeader::signature), header.magic);
+    header.version = BinaryHeader::current_version;
+    header.byte_order = BinaryHeader::byte_order_mark;
+    header.element_type = static_cast<std::uint32_t>(BinaryElement<T>::type);
+    header.layout = static_cast<std::uint32_t>(layout);
+    header.rows = n;
+    header.columns = m;
+    header.ld = (layout == Layout::row_major ? m : n);
+    header.alignment = alignment;
+    header.offset = (sizeof(BinaryHeader) + alignment - 1) / alignment * alignment;
+    return header;
+}
+
+template<typename T>
+void check_binary_header(const BinaryHeader &header, std::uint64_t file_bytes) {
+    if (!std::equal(std::begin(BinaryHeader::signature), std::end(BinaryHeader::signature), header.magic)) {
+        throw std::invalid_argument("file isn't a binary matrix file");
+    }
+    if (header.byte_order != BinaryHeader::byte_order_mark) {
+        throw std::invalid_argument("binary matrix file has different byte order");
+    }
+    if (header.version != BinaryHeader::current_version) {
+        throw std::invalid_argument("version of binary matrix file isn't supported");
+    }
+    if (header.element_type != static_cast<std::uint32_t>(BinaryElement<T>::type)) {
+        throw std::invalid_argument("type of elements of binary matrix file doesn't match");
+    }
+    if (header.layout != static_cast<std::uint32_t>(Layout::row_major) &&
+        header.layout != static_cast<std::uint32_t>(Layout::column_major)) {
+        throw std::invalid_argument("layout of binary matrix file is unknown");
+    }
+
+    // rows of row-major files and columns of column-major ones are "inner" lines
+    bool row_major = (header.layout == static_cast<std::uint32_t>(Layout::row_major));
+    std::uint64_t inner = (row_major ? header.columns : header.rows);
+    std::uint64_t outer = (row_major ? header.rows : header.columns);
+    if (header.alignment < alignof(T) || (header.alignment & (header.alignment - 1)) != 0 ||
+        header.offset < sizeof(BinaryHeader) || header.offset % header.alignment != 0 || header.ld < inner) {
+        throw std::invalid_argument("header of binary matrix file is corrupted");
+    }
+
+    // sizes are checked for overflow, so corrupted headers can't make payload look smaller than it is
+    std::uint64_t bytes = 0;
+    if (inner != 0 && outer != 0) {
+        std::uint64_t elements;
+        if (__builtin_mul_overflow(outer - 1, header.ld, &elements) ||
+            __builtin_add_overflow(elements, inner, &elements) ||
+            __builtin_mul_overflow(elements, sizeof(T), &bytes) ||
+            bytes > std::uint64_t(SIZE_MAX)) {
+            throw std::invalid_argument("header of binary matrix file is corrupted");
+        }
+    }
+    if (file_bytes != UINT64_MAX && (header.offset > file_bytes || bytes > file_bytes - header.offset)) {
+        throw std::invalid_argument("binary matrix file is truncated");
+    }
+}
+
+inline BinaryHeader read_binary_header(std::istream &istream) {
+    BinaryHeader header{};
+    if (!istream.read(reinterpret_cast<char*>(&header), sizeof(BinaryHeader))) {
+        throw std::invalid_argument("file isn't a binary matrix file");
+    }
+    return header;
+}
+
+// writing and reading implementation //
+
+template<typename T, typename E>
+void write_binary(std::ostream &ostream, const MatrixExpression<T, E> &expression, Layout layout, std::size_t alignment) {
+    const E &matrix = static_cast<const E&>(expression);
+    std::size_t n = matrix.n();
+    std::size_t m = matrix.m();
+
+    BinaryHeader header = binary_header<T>(n, m, layout, alignment);
+    ostream.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+    const char zeros[64] = {};
+    for (std::size_t padding = header.offset - sizeof(BinaryHeader); padding > 0; ) {
+        std::size_t count = std::min(padding, sizeof(zeros));
+        ostream.write(zeros, std::streamsize(count));
+        padding -= count;
+    }
+
+    bool written = false;
+    if constexpr (E::has_storage) {
+        // rows which lie in memory contiguously are written without copying
+        StorageView<T> view = matrix.view();
+        if (layout == Layout::row_major && view.col_stride == 1 && !view.conjugated) {
+            if (view.row_stride == m) {
+                ostream.write(reinterpret_cast<const char*>(view.pointer), std::streamsize(n * m * sizeof(T)));
+            }
+            else {
+                for (std::size_t i = 0; i < n; ++i) {
+                    ostream.write(reinterpret_cast<const char*>(view.pointer + i * view.row_stride), std::streamsize(m * sizeof(T)));
+                }
+            }
+            written = true;
+        }
+    }
+    if (!written && layout == Layout::row_major) {
+        ScratchBuffer<T> row = ScratchBuffer<T>(m);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                row.data()[j] = matrix[i, j];
+            }
+            ostream.write(reinterpret_cast<const char*>(row.data()), std::streamsize(m * sizeof(T)));
+        }
+    }
+    else if (!written) {
+        ScratchBuffer<T> column = ScratchBuffer<T>(n);
+        for (std::size_t j = 0; j < m; ++j) {
+            for (std::size_t i = 0; i < n; ++i) {
+                column.data()[i] = matrix[i, j];
+            }
+            ostream.write(reinterpret_cast<const char*>(column.data()), std::streamsize(n * sizeof(T)));
+        }
+    }
+
+    if (!ostream) {
+        throw std::runtime_error("binary matrix file can't be written");
+    }
+}
+
+template<typename T, typename E>
+void write_binary(const std::string &path, const MatrixExpression<T, E> &expression, Layout layout, std::size_t alignment) {
+    std::ofstream ostream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!ostream) {
+        throw std::runtime_error("file " + path + " can't be opened");
+    }
+    write_binary(ostream, expression, layout, alignment);
+    ostream.close();
+    if (!ostream) {
+        throw std::runtime_error("binary matrix file can't be written");
+    }
+}
+
+template<typename T>
+Matrix<T> load_binary_payload(const BinaryHeader &header, const T *data) {
+    std::size_t n = header.rows;
+    std::size_t m = header.columns;
+    std::size_t ld = header.ld;
+    auto result = Matrix<T>(n, m);
+    if (header.layout == static_cast<std::uint32_t>(Layout::row_major)) {
+        result.noalias() = ConstSubmatrix<T>(data, n, m, ld);
+        return result;
+    }
+
+    // column-major payload is transposed by tiles, so both reads and writes stay within few cache lines
+    constexpr std::size_t tile = 64;
+    for (std::size_t i0 = 0; i0 < n; i0 += tile) {
+        for (std::size_t j0 = 0; j0 < m; j0 += tile) {
+            for (std::size_t i = i0; i < std::min(i0 + tile, n); ++i) {
+                for (std::size_t j = j0; j < std::min(j0 + tile, m); ++j) {
+                    result[i, j] = data[j * ld + i];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> read_binary(std::istream &istream) {
+    std::istream::pos_type start = istream.tellg();
+    BinaryHeader header = read_binary_header(istream);
+
+    // size of seekable stream is measured from the header, so truncated stream is rejected before matrix is allocated
+    std::uint64_t file_bytes = UINT64_MAX;
+    if (start != std::istream::pos_type(-1)) {
+        std::istream::pos_type position = istream.tellg();
+        istream.seekg(0, std::ios::end);
+        std::istream::pos_type end = istream.tellg();
+        if (istream && end != std::istream::pos_type(-1)) {
+            file_bytes = std::uint64_t(end - start);
+        }
+        istream.clear();
+        istream.seekg(position);
+    }
+    check_binary_header<T>(header, file_bytes);
+    istream.ignore(std::streamsize(header.offset - sizeof(BinaryHeader)));
+
+    std::size_t n = header.rows;
+    std::size_t m = header.columns;
+    std::size_t ld = header.ld;
+    bool row_major = (header.layout == static_cast<std::uint32_t>(Layout::row_major));
+    if (file_bytes == UINT64_MAX) {
+        // payload of stream of unknown size is read by growing chunks, so corrupted header can't make
+        // memory be allocated beyond what stream really holds
+        std::size_t inner = (row_major ? m : n);
+        std::size_t outer = (row_major ? n : m);
+        std::size_t count = (inner != 0 && outer != 0 ? (outer - 1) * ld + inner : 0);
+        constexpr std::size_t chunk = (std::size_t(1) << 20) / sizeof(T);
+        std::vector<T> payload;
+        while (payload.size() < count) {
+            std::size_t size = payload.size();
+            payload.resize(size + std::min(count - size, std::max(chunk, size)));
+            if (!istream.read(reinterpret_cast<char*>(payload.data() + size), std::streamsize((payload.size() - size) * sizeof(T)))) {
+                throw std::invalid_argument("binary matrix file is truncated");
+            }
+        }
+        return load_binary_payload<T>(header, payload.data());
+    }
+
+    auto result = Matrix<T>(n, m);
+    if (row_major) {
+        if (ld == m) {
+            istream.read(reinterpret_cast<char*>(result.data()), std::streamsize(n * m * sizeof(T)));
+        }
+        else {
+            for (std::size_t i = 0; i < n && istream; ++i) {
+                istream.read(reinterpret_cast<char*>(result.data() + i * m), std::streamsize(m * sizeof(T)));
+                if (i + 1 < n) {
+                    istream.ignore(std::streamsize((ld - m) * sizeof(T)));
+                }
+            }
+        }
+    }
+    else {
+        ScratchBuffer<T> column = ScratchBuffer<T>(n);
+        for (std::size_t j = 0; j < m && istream; ++j) {
+            istream.read(reinterpret_cast<char*>(column.data()), std::streamsize(n * sizeof(T)));
+            for (std::size_t i = 0; i < n; ++i) {
+                result[i, j] = column.data()[i];
+            }
+            if (j + 1 < m) {
+                istream.ignore(std::streamsize((ld - n) * sizeof(T)));
+            }
+        }
+    }
+
+    if (!istream) {
+        throw std::invalid_argument("binary matrix file is truncated");
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> read_binary(const std::string &path) {
+    return MappedMatrix<T>(path).load();
+}
+
+// MappedMatrix implementation //
+
+template<typename T>
+std::size_t MappedMatrix<T>::n() const {
+    return header.rows;
+}
+
+template<typename T>
+std::size_t MappedMatrix<T>::m() const {
+    return header.columns;
+}
+
+template<typename T>
+const T* MappedMatrix<T>::data() const {
+    return reinterpret_cast<const T*>(static_cast<const char*>(mapping.data()) + header.offset);
+}
+
+template<typename T>
+std::size_t MappedMatrix<T>::ld() const {
+    return header.ld;
+}
+
+template<typename T>
+Layout MappedMatrix<T>::layout() const {
+    return static_cast<Layout>(header.layout);
+}
+
+template<typename T>
+ConstSubmatrix<T> MappedMatrix<T>::view() const {
+    return (*this)[Slice(0, n()), Slice(0, m())];
+}
+
+template<typename T>
+ConstSubmatrix<T> MappedMatrix<T>::operator[](Slice n_slice, Slice m_slice) const {
+    if (layout() != Layout::row_major) {
+        throw std::invalid_argument("only row-major binary matrix files can be viewed without copy");
+    }
+    if (n_slice.start > n_slice.end || n_slice.end > n() || m_slice.start > m_slice.end || m_slice.end > m()) {
+        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+    }
+    return ConstSubmatrix<T>(data() + n_slice.start * ld() + m_slice.start,
+                             n_slice.end - n_slice.start, m_slice.end - m_slice.start, ld());
+}
+
+template<typename T>
+Submatrix<T> MappedMatrix<T>::mutable_view() {
+    if (mode != MapMode::copy_on_write) {
+        throw std::invalid_argument("read-only mapping of binary matrix file can't be changed");
+    }
+    ConstSubmatrix<T> whole = view();
+    return Submatrix<T>(const_cast<T*>(whole.data()), whole.n(), whole.m(), whole.ld());
+}
+
+template<typename T>
+Matrix<T> MappedMatrix<T>::load() const {
+    return load_binary_payload<T>(header, data());
+}
+
+template<typename T>
+MappedMatrix<T>::MappedMatrix(const std::string &path, MapMode mode_) : mapping(path, mode_), header{}, mode(mode_) {
+    if (mapping.size() < sizeof(BinaryHeader)) {
+        throw std::invalid_argument("file isn't a binary matrix file");
+    }
+    std::memcpy(&header, mapping.data(), sizeof(BinaryHeader));
+    check_binary_header<T>(header, mapping.size());
+}
@@ -0,0 +1,36 @@
+#ifndef MATRIX_CALCULATOR_FILE_MAPPING_H
+#define MATRIX_CALCULATOR_FILE_MAPPING_H
+
+#include <cstddef>
+#include <string>
+
+// way of mapping file into memory
+enum class MapMode {
+    read_only, // pages are shared with file and can't be changed
+    copy_on_write // pages can be changed, changed pages are copied and file stays the same
+};
+
+// file mapped into memory, unmapped on destruction
+class FileMapping {
+private:
+    void *pointer;
+    std::size_t bytes;
+
+public:
+    // return address and size of mapping
+    void* data() const;
+    std::size_t size() const;
+
+    // throws std::runtime_error if file can't be opened or mapped
+    FileMapping(const std::string &path, MapMode mode);
+    FileMapping(const FileMapping &other) = delete;
+    FileMapping& operator=(const FileMapping &other) = delete;
+    // moved-from mapping is left empty
+    FileMapping(FileMapping &&other) noexcept;
+    FileMapping& operator=(FileMapping &&other) noexcept;
+    ~FileMapping();
+};
+
+#include "file-mapping.tpp"
+
+#endif //MATRIX_CALCULATOR_FILE_MAPPING_H
@@ -0,0 +1,62 @@
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// FileMapping implementation //
+
+inline void* FileMapping::data() const {
+    return pointer;
+}
+
+inline std::size_t FileMapping::size() const {
+    return bytes;
+}
+
+inline FileMapping::FileMapping(const std::string &path, MapMode mode) : pointer(nullptr), bytes(0) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("file " + path + " can't be opened");
+    }
+    struct stat status{};
+    if (::fstat(descriptor, &status) != 0) {
+        ::close(descriptor);
+        throw std::runtime_error("size of file " + path + " can't be obtained");
+    }
+
+    bytes = std::size_t(status.st_size);
+    if (bytes != 0) {
+        // private mapping never changes file, writes to copy-on-write mapping go to private copies of pages
+        int protection = (mode == MapMode::copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ);
+        pointer = ::mmap(nullptr, bytes, protection, MAP_PRIVATE, descriptor, 0);
+        if (pointer == MAP_FAILED) {
+            pointer = nullptr;
+            ::close(descriptor);
+            throw std::runtime_error("file " + path + " can't be mapped into memory");
+        }
+    }
+    // mapping stays valid after file is closed
+    ::close(descriptor);
+}
+
+inline FileMapping::FileMapping(FileMapping &&other) noexcept :
+pointer(std::exchange(other.pointer, nullptr)), bytes(std::exchange(other.bytes, 0)) {}
+
+inline FileMapping& FileMapping::operator=(FileMapping &&other) noexcept {
+    if (this != &other) {
+        if (pointer != nullptr) {
+            ::munmap(pointer, bytes);
+        }
+        pointer = std::exchange(other.pointer, nullptr);
+        bytes = std::exchange(other.bytes, 0);
+    }
+    return *this;
+}
+
+inline FileMapping::~FileMapping() {
+    if (pointer != nullptr) {
+        ::munmap(pointer, bytes);
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef MATRIX_CALCULATOR_FIXED_MATRIX_H
+#define MATRIX_CALCULATOR_FIXED_MATRIX_H
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include "../matrix.h"
+
+// class of matrix with size known at compile time, elements are stored row by row inside the object
+// T - type of elements of matrix
+// Rows, Cols - size of matrix
+template<typename T, std::size_t Rows, std::size_t Cols>
+class FixedMatrix : public MatrixExpression<T, FixedMatrix<T, Rows, Cols>> {
+protected:
+    std::array<T, Rows * Cols> elements;
+
+public:
+    // class FixedMatrix contains data
+    static constexpr bool has_data = true;
+
+    // elements of matrix lie in memory
+    static constexpr bool has_storage = true;
+
+    // rows of matrix are contiguous and can be loaded by packets
+    static constexpr bool has_packets = PacketTraits<T>::vectorizable;
+
+    // returns copy of element on i-th row and j-th column
+    constexpr T operator[](std::size_t i, std::size_t j) const;
+
+    // returns reference to element on i-th row and j-th column
+    constexpr T& operator[](std::size_t i, std::size_t j);
+
+    // return submatrix
+    ConstSubmatrix<T> operator[](Slice n_slice, Slice m_slice) const;
+    Submatrix<T> operator[](Slice n_slice, Slice m_slice);
+
+    // return size of matrix
+    constexpr std::size_t n() const;
+    constexpr std::size_t m() const;
+
+    // return pointer to the first element and leading dimension of matrix
+    const T* data() const;
+    T* data();
+    constexpr std::size_t ld() const;
+
+    // return description of memory occupied by matrix
+    StorageView<T> view() const;
+    MemoryRegion region() const;
+
+    // returns true if matrix overlaps "region", except when it occupies exactly the same memory and "aligned" is true
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
+    // substitute elements of matrix with elements of "other"
+    template<typename T2, typename E2>
+    constexpr FixedMatrix& operator=(const MatrixExpression<T2, E2> &other);
+
+    // surface-operations which change matrix
+    template<typename T2, typename E2>
+    constexpr FixedMatrix& operator+=(const MatrixExpression<T2, E2> &other);
+
+    template<typename T2, typename E2>
+    constexpr FixedMatrix& operator-=(const MatrixExpression<T2, E2> &other);
+
+    constexpr FixedMatrix& operator*=(T val);
+
+    constexpr FixedMatrix& operator/=(T val);
+
+    // matrix of zeros
+    constexpr FixedMatrix();
+
+    // matrix with elements listed row by row
+    constexpr FixedMatrix(std::initializer_list<T> elements);
+
+    template<typename T2, typename E2>
+    constexpr FixedMatrix(const MatrixExpression<T2, E2> &expression);
+};
+
+// surface-operations on fixed-size matrices are evaluated immediately with loops of known length //
+
+template<typename T, std::size_t Rows, std::size_t K, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator*(const FixedMatrix<T, Rows, K> &first, const FixedMatrix<T, K, Cols> &second);
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator+(const FixedMatrix<T, Rows, Cols> &first, const FixedMatrix<T, Rows, Cols> &second);
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator-(const FixedMatrix<T, Rows, Cols> &first, const FixedMatrix<T, Rows, Cols> &second);
+
+#include "fixed-matrix.tpp"
+
+#endif //MATRIX_CALCULATOR_FIXED_MATRIX_H
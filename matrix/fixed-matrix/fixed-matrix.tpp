@@ -0,0 +1,180 @@
+// FixedMatrix implementation //
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr T FixedMatrix<T, Rows, Cols>::operator[](std::size_t i, std::size_t j) const {
+    return elements[i * Cols + j];
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr T& FixedMatrix<T, Rows, Cols>::operator[](std::size_t i, std::size_t j) {
+    return elements[i * Cols + j];
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+ConstSubmatrix<T> FixedMatrix<T, Rows, Cols>::operator[](Slice n_slice, Slice m_slice) const {
+    if (n_slice.start > n_slice.end || n_slice.end > Rows || m_slice.start > m_slice.end || m_slice.end > Cols) {
+        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+    }
+    return ConstSubmatrix<T>(data() + n_slice.start * Cols + m_slice.start,
+                             n_slice.end - n_slice.start, m_slice.end - m_slice.start, Cols);
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+Submatrix<T> FixedMatrix<T, Rows, Cols>::operator[](Slice n_slice, Slice m_slice) {
+    if (n_slice.start > n_slice.end || n_slice.end > Rows || m_slice.start > m_slice.end || m_slice.end > Cols) {
+        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+    }
+    return Submatrix<T>(data() + n_slice.start * Cols + m_slice.start,
+                        n_slice.end - n_slice.start, m_slice.end - m_slice.start, Cols);
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr std::size_t FixedMatrix<T, Rows, Cols>::n() const {
+    return Rows;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr std::size_t FixedMatrix<T, Rows, Cols>::m() const {
+    return Cols;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+const T* FixedMatrix<T, Rows, Cols>::data() const {
+    return elements.data();
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+T* FixedMatrix<T, Rows, Cols>::data() {
+    return elements.data();
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr std::size_t FixedMatrix<T, Rows, Cols>::ld() const {
+    return Cols;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+StorageView<T> FixedMatrix<T, Rows, Cols>::view() const {
+    return StorageView<T>{data(), Cols, 1, false};
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+MemoryRegion FixedMatrix<T, Rows, Cols>::region() const {
+    return MemoryRegion{reinterpret_cast<std::uintptr_t>(data()), Rows, Cols * sizeof(T), Cols * sizeof(T)};
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+bool FixedMatrix<T, Rows, Cols>::aliases(const MemoryRegion &region_, bool aligned) const {
+    return !(aligned && region() == region_) && region().overlaps(region_);
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+template<typename P>
+void FixedMatrix<T, Rows, Cols>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    simd_load(packet, reinterpret_cast<const typename PacketTraits<T>::real_type*>(data() + i * Cols + j));
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+template<typename T2, typename E2>
+constexpr FixedMatrix<T, Rows, Cols>& FixedMatrix<T, Rows, Cols>::operator=(const MatrixExpression<T2, E2> &other) {
+    // result is collected in a copy, so "other" may read this matrix
+    *this = FixedMatrix<T, Rows, Cols>(other);
+    return *this;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+template<typename T2, typename E2>
+constexpr FixedMatrix<T, Rows, Cols>& FixedMatrix<T, Rows, Cols>::operator+=(const MatrixExpression<T2, E2> &other) {
+    FixedMatrix<T, Rows, Cols> addend = other;
+    for (std::size_t k = 0; k < Rows * Cols; ++k) {
+        elements[k] += addend.elements[k];
+    }
+    return *this;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+template<typename T2, typename E2>
+constexpr FixedMatrix<T, Rows, Cols>& FixedMatrix<T, Rows, Cols>::operator-=(const MatrixExpression<T2, E2> &other) {
+    FixedMatrix<T, Rows, Cols> subtrahend = other;
+    for (std::size_t k = 0; k < Rows * Cols; ++k) {
+        elements[k] -= subtrahend.elements[k];
+    }
+    return *this;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols>& FixedMatrix<T, Rows, Cols>::operator*=(T val) {
+    for (std::size_t k = 0; k < Rows * Cols; ++k) {
+        elements[k] *= val;
+    }
+    return *this;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols>& FixedMatrix<T, Rows, Cols>::operator/=(T val) {
+    for (std::size_t k = 0; k < Rows * Cols; ++k) {
+        elements[k] /= val;
+    }
+    return *this;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols>::FixedMatrix() : elements{} {}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols>::FixedMatrix(std::initializer_list<T> elements_) : elements{} {
+    if (elements_.size() != Rows * Cols) {
+        throw std::invalid_argument("count of elements doesn't match size of matrix");
+    }
+    std::copy(elements_.begin(), elements_.end(), elements.begin());
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+template<typename T2, typename E2>
+constexpr FixedMatrix<T, Rows, Cols>::FixedMatrix(const MatrixExpression<T2, E2> &expression) : elements{} {
+    if (expression.n() != Rows || expression.m() != Cols) {
+        throw std::invalid_argument("size of expression doesn't match size of matrix");
+    }
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            elements[i * Cols + j] = static_cast<const E2&>(expression)[i, j];
+        }
+    }
+}
+
+// surface-operations on fixed-size matrices implementation //
+
+template<typename T, std::size_t Rows, std::size_t K, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator*(const FixedMatrix<T, Rows, K> &first, const FixedMatrix<T, K, Cols> &second) {
+    FixedMatrix<T, Rows, Cols> result;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t k = 0; k < K; ++k) {
+            for (std::size_t j = 0; j < Cols; ++j) {
+                result[i, j] += first[i, k] * second[k, j];
+            }
+        }
+    }
+    return result;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator+(const FixedMatrix<T, Rows, Cols> &first, const FixedMatrix<T, Rows, Cols> &second) {
+    FixedMatrix<T, Rows, Cols> result = first;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            result[i, j] += second[i, j];
+        }
+    }
+    return result;
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+constexpr FixedMatrix<T, Rows, Cols> operator-(const FixedMatrix<T, Rows, Cols> &first, const FixedMatrix<T, Rows, Cols> &second) {
+    FixedMatrix<T, Rows, Cols> result = first;
+    for (std::size_t i = 0; i < Rows; ++i) {
+        for (std::size_t j = 0; j < Cols; ++j) {
+            result[i, j] -= second[i, j];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef MATRIX_CALCULATOR_GEMM_H
+#define MATRIX_CALCULATOR_GEMM_H
+
+#include <complex>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../simd/simd.h"
+#include "../thread-pool/thread-pool.h"
+#include "../matrix-expression/matrix-expression.h"
+
+// micro-kernel of GEMM and block sizes it is tuned for
+// MR x NR - size of block of C kept in registers by micro-kernel
+// MC x KC - size of packed block of A which stays in L2 cache
+// KC x NC - size of packed block of B which stays in L3 cache
+// T - type of elements of matrices
+template<typename T>
+struct GemmKernel {
+    std::size_t MR;
+    std::size_t NR;
+    std::size_t MC;
+    std::size_t KC;
+    std::size_t NC;
+
+    // adds product of packed MR x kc panel of A and packed kc x NR panel of B to mr x nr block of C
+    void (*micro_kernel)(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc, std::size_t mr, std::size_t nr);
+};
+
+// returns micro-kernel for elements of type T suited to instruction set of processor
+template<typename T>
+GemmKernel<T> gemm_kernel();
+
+// products with fewer multiplications than GEMM_THRESHOLD are computed without packing
+constexpr std::size_t GEMM_THRESHOLD = 32 * 32 * 32;
+
+// adds A * x to y, where A is n x k matrix, x is k x 1 matrix and y is vector of n elements "incy" apart
+template<typename T>
+void gemv(std::size_t n, std::size_t k, StorageView<T> A, StorageView<T> x, T *y, std::size_t incy);
+
+// adds alpha * x * y^T to A, where x is n x 1 and y is m x 1 matrix, A is n x m matrix with leading dimension "lda"
+template<typename T>
+void ger(std::size_t n, std::size_t m, T alpha, StorageView<T> x, StorageView<T> y, T *A, std::size_t lda);
+
+// computes C = A * B, where A is n x k, B is k x m and C is n x m matrix with leading dimension "ldc".
+// Large products are split into tiles computed by thread pool, result doesn't depend on count of threads
+template<typename T>
+void gemm(std::size_t n, std::size_t m, std::size_t k, StorageView<T> A, StorageView<T> B, T *C, std::size_t ldc);
+
+#include "gemm.tpp"
+
+#endif //MATRIX_CALCULATOR_GEMM_H
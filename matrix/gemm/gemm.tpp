@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+// helper functions of GEMM //
+
+// c += a * b, complex version avoids NaN/inf recovery of std::complex multiplication
+template<typename T>
+inline void multiply_add(T &c, T a, T b) {
+    c += a * b;
+}
+
+template<typename T>
+inline void multiply_add(std::complex<T> &c, std::complex<T> a, std::complex<T> b) {
+    c = std::complex<T>(c.real() + a.real() * b.real() - a.imag() * b.imag(),
+                        c.imag() + a.real() * b.imag() + a.imag() * b.real());
+}
+
+// returns conjugated "val" for complex numbers and "val" itself for real ones
+template<typename T>
+inline T conjugate(T val) {
+    return val;
+}
+
+template<typename T>
+inline std::complex<T> conjugate(std::complex<T> val) {
+    return std::conj(val);
+}
+
+// returns element on i-th row and j-th column of "view"
+template<typename T>
+inline T element(const StorageView<T> &view, std::size_t i, std::size_t j) {
+    T val = view.pointer[i * view.row_stride + j * view.col_stride];
+    return (view.conjugated ? conjugate(val) : val);
+}
+
+// returns thread local buffer of at least "size" elements, "index" distinguishes buffers for A and B
+template<typename T>
+T* gemm_buffer(std::size_t index, std::size_t size) {
+    thread_local std::vector<T, AlignedAllocator<T>> buffers[2];
+    if (buffers[index].size() < size) {
+        buffers[index].resize(size);
+    }
+    return buffers[index].data();
+}
+
+// packs mc x kc block of A starting at (ic, pc) into row panels of height MR, each panel is stored column by column
+// panels are padded with zeros up to MR rows
+template<typename T>
+void pack_A(const StorageView<T> &A, std::size_t ic, std::size_t pc, std::size_t mc, std::size_t kc,
+            std::size_t MR, T *buffer) {
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        std::size_t mr = std::min(MR, mc - ir);
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t i = 0; i < mr; ++i) {
+                buffer[i] = element(A, ic + ir + i, pc + p);
+            }
+            for (std::size_t i = mr; i < MR; ++i) {
+                buffer[i] = T(0);
+            }
+            buffer += MR;
+        }
+    }
+}
+
+// packs kc x nc block of B starting at (pc, jc) into column panels of width NR, each panel is stored row by row
+// panels are padded with zeros up to NR columns
+template<typename T>
+void pack_B(const StorageView<T> &B, std::size_t pc, std::size_t jc, std::size_t kc, std::size_t nc,
+            std::size_t NR, T *buffer) {
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        std::size_t nr = std::min(NR, nc - jr);
+        for (std::size_t p = 0; p < kc; ++p) {
+            if (B.col_stride == 1 && !B.conjugated) {
+                const T *row = B.pointer + (pc + p) * B.row_stride + jc + jr;
+                std::copy(row, row + nr, buffer);
+            }
+            else {
+                for (std::size_t j = 0; j < nr; ++j) {
+                    buffer[j] = element(B, pc + p, jc + jr + j);
+                }
+            }
+            for (std::size_t j = nr; j < NR; ++j) {
+                buffer[j] = T(0);
+            }
+            buffer += NR;
+        }
+    }
+}
+
+// micro-kernels implementation //
+
+// micro-kernel for any type of elements, used when no vectorized kernel exists
+template<typename T, std::size_t MR, std::size_t NR>
+void scalar_micro_kernel(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    T accumulator[MR][NR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            for (std::size_t j = 0; j < NR; ++j) {
+                multiply_add(accumulator[i][j], A[i], B[j]);
+            }
+        }
+        A += MR;
+        B += NR;
+    }
+
+    for (std::size_t i = 0; i < mr; ++i) {
+        for (std::size_t j = 0; j < nr; ++j) {
+            C[i * ldc + j] += accumulator[i][j];
+        }
+    }
+}
+
+// micro-kernel for real numbers, row of B panel is held in NR / W vectors of W elements
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+[[gnu::always_inline]] inline void real_micro_kernel(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc,
+                                                     std::size_t mr, std::size_t nr) {
+    using Vector = typename SimdVector<T, W>::type;
+    constexpr std::size_t NV = NR / W;
+
+    Vector accumulator[MR][NV] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        Vector b[NV];
+        for (std::size_t v = 0; v < NV; ++v) {
+            simd_load(b[v], B + v * W);
+        }
+        for (std::size_t i = 0; i < MR; ++i) {
+            Vector a = Vector{} + A[i];
+            for (std::size_t v = 0; v < NV; ++v) {
+                accumulator[i][v] += a * b[v];
+            }
+        }
+        A += MR;
+        B += NR;
+    }
+
+    if (mr == MR && nr == NR) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            for (std::size_t v = 0; v < NV; ++v) {
+                Vector c;
+                simd_load(c, C + i * ldc + v * W);
+                simd_store(C + i * ldc + v * W, c + accumulator[i][v]);
+            }
+        }
+    }
+    else {
+        T result[MR][NR];
+        std::memcpy(result, accumulator, sizeof(result));
+        for (std::size_t i = 0; i < mr; ++i) {
+            for (std::size_t j = 0; j < nr; ++j) {
+                C[i * ldc + j] += result[i][j];
+            }
+        }
+    }
+}
+
+// micro-kernel for complex numbers, real and imaginary parts of A are broadcast separately
+// and multiplied by interleaved row of B panel, parts of product are combined once at the end
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+[[gnu::always_inline]] inline void complex_micro_kernel(std::size_t kc, const std::complex<T> *A, const std::complex<T> *B,
+                                                        std::complex<T> *C, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    using Vector = typename SimdVector<T, W>::type;
+    constexpr std::size_t NV = 2 * NR / W;
+
+    const T *a = reinterpret_cast<const T*>(A);
+    const T *b = reinterpret_cast<const T*>(B);
+
+    Vector real_accumulator[MR][NV] = {};
+    Vector imag_accumulator[MR][NV] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        Vector row[NV];
+        for (std::size_t v = 0; v < NV; ++v) {
+            simd_load(row[v], b + v * W);
+        }
+        for (std::size_t i = 0; i < MR; ++i) {
+            Vector a_real = Vector{} + a[2 * i];
+            Vector a_imag = Vector{} + a[2 * i + 1];
+            for (std::size_t v = 0; v < NV; ++v) {
+                real_accumulator[i][v] += a_real * row[v];
+                imag_accumulator[i][v] += a_imag * row[v];
+            }
+        }
+        a += 2 * MR;
+        b += 2 * NR;
+    }
+
+    T real_part[MR][2 * NR];
+    T imag_part[MR][2 * NR];
+    std::memcpy(real_part, real_accumulator, sizeof(real_part));
+    std::memcpy(imag_part, imag_accumulator, sizeof(imag_part));
+    for (std::size_t i = 0; i < mr; ++i) {
+        for (std::size_t j = 0; j < nr; ++j) {
+            C[i * ldc + j] += std::complex<T>(real_part[i][2 * j] - imag_part[i][2 * j + 1],
+                                              real_part[i][2 * j + 1] + imag_part[i][2 * j]);
+        }
+    }
+}
+
+// selects real or complex micro-kernel
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+[[gnu::always_inline]] inline void vector_micro_kernel(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc,
+                                                       std::size_t mr, std::size_t nr) {
+    if constexpr (std::is_floating_point_v<T>) {
+        real_micro_kernel<T, MR, NR, W>(kc, A, B, C, ldc, mr, nr);
+    }
+    else {
+        complex_micro_kernel<typename T::value_type, MR, NR, W>(kc, A, B, C, ldc, mr, nr);
+    }
+}
+
+// vectorized micro-kernels compiled for every supported instruction set
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+void micro_kernel_sse2(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    vector_micro_kernel<T, MR, NR, W>(kc, A, B, C, ldc, mr, nr);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+[[gnu::target("avx2,fma")]]
+void micro_kernel_avx2(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    vector_micro_kernel<T, MR, NR, W>(kc, A, B, C, ldc, mr, nr);
+}
+
+template<typename T, std::size_t MR, std::size_t NR, std::size_t W>
+[[gnu::target("avx512f")]]
+void micro_kernel_avx512(std::size_t kc, const T *A, const T *B, T *C, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    vector_micro_kernel<T, MR, NR, W>(kc, A, B, C, ldc, mr, nr);
+}
+#endif
+
+// returns vectorized micro-kernel for T and "level", register blocks fill about half of vector registers
+// V - type of real numbers T consists of
+template<typename T, typename V>
+GemmKernel<T> vector_gemm_kernel(SimdLevel level) {
+    // complex numbers take two lanes of vector
+    constexpr std::size_t lanes = sizeof(T) / sizeof(V);
+    constexpr std::size_t KC = 256 / lanes;
+    constexpr std::size_t W_sse2 = 16 / sizeof(V);
+    constexpr std::size_t W_avx2 = 32 / sizeof(V);
+    constexpr std::size_t W_avx512 = 64 / sizeof(V);
+
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::avx512:
+            return {8 / lanes, 3 * W_avx512 / lanes, 96 / lanes, KC, 4032,
+                    &micro_kernel_avx512<T, 8 / lanes, 3 * W_avx512 / lanes, W_avx512>};
+        case SimdLevel::avx2:
+            return {6 / lanes, 2 * W_avx2 / lanes, 96 / lanes, KC, 4096,
+                    &micro_kernel_avx2<T, 6 / lanes, 2 * W_avx2 / lanes, W_avx2>};
+#endif
+        case SimdLevel::sse2:
+            return {4 / lanes, 2 * W_sse2 / lanes, 128 / lanes, KC, 4096,
+                    &micro_kernel_sse2<T, 4 / lanes, 2 * W_sse2 / lanes, W_sse2>};
+        default:
+            return {4, 4, 128, KC, 4096, &scalar_micro_kernel<T, 4, 4>};
+    }
+}
+
+template<typename T>
+GemmKernel<T> gemm_kernel() {
+    if constexpr (PacketTraits<T>::vectorizable) {
+        return vector_gemm_kernel<T, typename PacketTraits<T>::real_type>(simd_level());
+    }
+    else {
+        return GemmKernel<T>{4, 4, 128, 256, 4096, &scalar_micro_kernel<T, 4, 4>};
+    }
+}
+
+// computes product of small matrices without packing
+template<typename T>
+void gemm_small(std::size_t n, std::size_t m, std::size_t k, StorageView<T> A, StorageView<T> B, T *C, std::size_t ldc) {
+    for (std::size_t i = 0; i < n; ++i) {
+        T *row = C + i * ldc;
+        for (std::size_t p = 0; p < k; ++p) {
+            T a = element(A, i, p);
+            for (std::size_t j = 0; j < m; ++j) {
+                multiply_add(row[j], a, element(B, p, j));
+            }
+        }
+    }
+}
+
+// GEMV implementation //
+
+template<typename T>
+void gemv(std::size_t n, std::size_t k, StorageView<T> A, StorageView<T> x, T *y, std::size_t incy) {
+    if (A.col_stride == 1 && !A.conjugated) {
+        // rows of A are contiguous: y[i] is dot product of i-th row and x, partial sums hide latency of additions
+        const T *x_data = x.pointer;
+        ScratchBuffer<T> x_copy;
+        if (x.row_stride != 1 || x.conjugated) {
+            x_copy.resize(k);
+            for (std::size_t p = 0; p < k; ++p) {
+                x_copy.data()[p] = element(x, p, 0);
+            }
+            x_data = x_copy.data();
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const T *row = A.pointer + i * A.row_stride;
+            T sums[4] = {T(0), T(0), T(0), T(0)};
+            std::size_t p = 0;
+            for (; p + 4 <= k; p += 4) {
+                multiply_add(sums[0], row[p], x_data[p]);
+                multiply_add(sums[1], row[p + 1], x_data[p + 1]);
+                multiply_add(sums[2], row[p + 2], x_data[p + 2]);
+                multiply_add(sums[3], row[p + 3], x_data[p + 3]);
+            }
+            for (; p < k; ++p) {
+                multiply_add(sums[0], row[p], x_data[p]);
+            }
+            y[i * incy] += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+    }
+    else if (A.row_stride == 1 && !A.conjugated && incy == 1) {
+        // columns of A are contiguous: y is accumulated column by column
+        for (std::size_t p = 0; p < k; ++p) {
+            const T *column = A.pointer + p * A.col_stride;
+            T a = element(x, p, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                multiply_add(y[i], column[i], a);
+            }
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t p = 0; p < k; ++p) {
+                multiply_add(y[i * incy], element(A, i, p), element(x, p, 0));
+            }
+        }
+    }
+}
+
+// GER implementation //
+
+template<typename T>
+void ger(std::size_t n, std::size_t m, T alpha, StorageView<T> x, StorageView<T> y, T *A, std::size_t lda) {
+    // y is gathered into contiguous buffer, so every row of A is updated by one vectorizable loop
+    const T *y_data = y.pointer;
+    ScratchBuffer<T> y_copy;
+    if (y.row_stride != 1 || y.conjugated) {
+        y_copy.resize(m);
+        for (std::size_t j = 0; j < m; ++j) {
+            y_copy.data()[j] = element(y, j, 0);
+        }
+        y_data = y_copy.data();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        T *row = A + i * lda;
+        T a = alpha * element(x, i, 0);
+        for (std::size_t j = 0; j < m; ++j) {
+            multiply_add(row[j], a, y_data[j]);
+        }
+    }
+}
+
+// GEMM implementation //
+
+template<typename T>
+void gemm(std::size_t n, std::size_t m, std::size_t k, StorageView<T> A, StorageView<T> B, T *C, std::size_t ldc) {
+    for (std::size_t i = 0; i < n; ++i) {
+        std::fill(C + i * ldc, C + i * ldc + m, T(0));
+    }
+
+    // products with vector are computed without packing, C^T = B^T * A^T if A is row vector
+    if (m == 1) {
+        gemv(n, k, A, B, C, ldc);
+        return;
+    }
+    if (n == 1) {
+        gemv(m, k, StorageView<T>{B.pointer, B.col_stride, B.row_stride, B.conjugated},
+             StorageView<T>{A.pointer, A.col_stride, A.row_stride, A.conjugated}, C, 1);
+        return;
+    }
+
+    if (n * m * k < GEMM_THRESHOLD) {
+        gemm_small(n, m, k, A, B, C, ldc);
+        return;
+    }
+
+    const GemmKernel<T> kernel = gemm_kernel<T>();
+    // blocks are padded up to whole panels, block of B is shared by threads
+    T *packed_B = gemm_buffer<T>(1, (kernel.NC + kernel.NR) * kernel.KC);
+
+    // tile is block of MC rows and range of NR panels of packed B, blocks of rows are split into ranges of panels
+    // when there are fewer of them than threads. Every element of C is computed by the same sequence of operations
+    // whatever tiles are, so result doesn't depend on count of threads
+    std::size_t row_blocks = (n + kernel.MC - 1) / kernel.MC;
+    std::size_t threads = thread_count();
+
+    for (std::size_t jc = 0; jc < m; jc += kernel.NC) {
+        std::size_t nc = std::min(kernel.NC, m - jc);
+        std::size_t panels = (nc + kernel.NR - 1) / kernel.NR;
+        std::size_t ranges = std::min(panels, (threads + row_blocks - 1) / row_blocks);
+
+        for (std::size_t pc = 0; pc < k; pc += kernel.KC) {
+            std::size_t kc = std::min(kernel.KC, k - pc);
+            pack_B(B, pc, jc, kc, nc, kernel.NR, packed_B);
+
+            parallel_for(row_blocks * ranges, n * nc * kc, [&](std::size_t tile) {
+                std::size_t ic = (tile / ranges) * kernel.MC;
+                std::size_t mc = std::min(kernel.MC, n - ic);
+                std::size_t first_panel = panels * (tile % ranges) / ranges;
+                std::size_t last_panel = panels * (tile % ranges + 1) / ranges;
+
+                // every thread packs block of A to its own buffer
+                T *packed_A = gemm_buffer<T>(0, (kernel.MC + kernel.MR) * kernel.KC);
+                pack_A(A, ic, pc, mc, kc, kernel.MR, packed_A);
+
+                for (std::size_t jr = first_panel * kernel.NR; jr < std::min(nc, last_panel * kernel.NR); jr += kernel.NR) {
+                    std::size_t nr = std::min(kernel.NR, nc - jr);
+                    for (std::size_t ir = 0; ir < mc; ir += kernel.MR) {
+                        std::size_t mr = std::min(kernel.MR, mc - ir);
+                        kernel.micro_kernel(kc, packed_A + ir * kc, packed_B + jr * kc,
+                                            C + (ic + ir) * ldc + jc + jr, ldc, mr, nr);
+                    }
+                }
+            });
+        }
+    }
+}
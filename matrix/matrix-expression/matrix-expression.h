@@ -1,6 +1,35 @@
 #ifndef MATRIX_CALCULATOR_MATRIXEXPRESSION_H
 #define MATRIX_CALCULATOR_MATRIXEXPRESSION_H
 
+#include <cstdint>
+#include <type_traits>
+#include "../simd/simd.h"
+#include "../scratch/scratch.h"
+
+// description of elements of expression which lie in memory
+// element on i-th row and j-th column is pointer[i * row_stride + j * col_stride], conjugated if "conjugated" is true
+// T - type of elements
+template<typename T>
+struct StorageView {
+    const T *pointer;
+    std::size_t row_stride;
+    std::size_t col_stride;
+    bool conjugated;
+};
+
+// memory occupied by elements of matrix: "n" rows of "row_size" bytes, starting "row_stride" bytes apart from "begin"
+struct MemoryRegion {
+    std::uintptr_t begin;
+    std::size_t n;
+    std::size_t row_size;
+    std::size_t row_stride;
+
+    // returns true if regions have at least one common byte
+    bool overlaps(const MemoryRegion &other) const;
+
+    bool operator==(const MemoryRegion &other) const = default;
+};
+
 // abstract class of expression with matrices
 // T - type of elements of matrix obtained by evaluating expression
 // E - subclass of MatrixExpression
@@ -12,14 +41,43 @@ public:
     // has_data equals true if class contains data (not reference to data) about elements of matrix
     static constexpr bool has_data = false;
 
+    // has_storage equals true if elements of expression lie in memory and can be described by StorageView,
+    // such expressions provide "StorageView<T> view() const"
+    static constexpr bool has_storage = false;
+
+    // has_packets equals true if several consecutive elements of a row can be evaluated at once, such expressions provide
+    // "template<typename P> void load_packet(P &packet, std::size_t i, std::size_t j) const" (see packet_assign)
+    static constexpr bool has_packets = false;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating expression
     T operator[](std::size_t i, std::size_t j) const;
 
     // return size of matrix obtained by evaluating expression
     std::size_t n() const;
     std::size_t m() const;
+
+    // returns true if evaluating expression may read memory of "region" which assignment writes to.
+    // "aligned" is true if element on i-th row and j-th column of expression is used only for the same element of result,
+    // then reading exactly the element being written is harmless.
+    // expressions which don't describe memory they read are assumed to alias
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // returns estimated count of operations needed to evaluate one element, elements lying in memory cost nothing
+    std::size_t cost() const;
+
+    // prepares expression for evaluation of its elements, called by evaluate before reading elements (see Product::prepare)
+    void prepare() const;
+
+    // releases temporaries made by prepare, called by evaluate when elements are written,
+    // so elements read afterwards reflect current values of operands
+    void release() const;
 };
 
+// writes elements of "expression" to memory starting at "destination" with leading dimension "ld",
+// expression is prepared first and released afterwards (defined in matrix.h)
+template<typename T1, typename T2, typename E2>
+void evaluate(const MatrixExpression<T2, E2> &expression, T1 *destination, std::size_t ld);
+
 // throw exception if matrices are not match by row count, column count or column-row count respectively
 template<typename T1, typename E1, typename T2, typename E2>
 void check_n(const MatrixExpression<T1, E1> &first, const MatrixExpression<T2, E2> &second);
@@ -39,6 +97,9 @@ protected:
     std::conditional_t<E::has_data, const E&, E> expression;
 
 public:
+    // negation is evaluated by packets if expression is
+    static constexpr bool has_packets = E::has_packets;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating negation of the expression
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -46,6 +107,21 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating negation of the expression may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare operands for evaluation and release them (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
+    // returns negated expression
+    const E& operand() const;
+
     explicit Negation(const MatrixExpression<T, E>& expression);
 };
 
@@ -58,6 +134,10 @@ protected:
     std::conditional_t<E1::has_data, const E1&, E1> first;
     std::conditional_t<E2::has_data, const E2&, E2> second;
 public:
+    // summation is evaluated by packets if both expressions are
+    static constexpr bool has_packets = E1::has_packets && E2::has_packets &&
+        std::is_same_v<typename E1::value_type, T> && std::is_same_v<typename E2::value_type, T>;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating summation of the expressions
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -65,6 +145,18 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating summation of the expressions may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare operands for evaluation and release them (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
     template<typename T1, typename T2>
     Summation(const MatrixExpression<T1, E1> &first, const MatrixExpression<T2, E2> &second);
 };
@@ -79,6 +171,10 @@ protected:
     std::conditional_t<E2::has_data, const E2&, E2> second;
 
 public:
+    // subtraction is evaluated by packets if both expressions are
+    static constexpr bool has_packets = E1::has_packets && E2::has_packets &&
+        std::is_same_v<typename E1::value_type, T> && std::is_same_v<typename E2::value_type, T>;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating subtraction of the expressions
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -86,10 +182,38 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating subtraction of the expressions may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare operands for evaluation and release them (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
     template<typename T1, typename T2>
     Subtraction(const MatrixExpression<T1, E1> &first, const MatrixExpression<T2, E2> &second);
 };
 
+// returns true if E is chain of products with elements of type T1 which is worth reordering (see ProductChain)
+template<typename T1, typename E>
+constexpr bool is_product_chain();
+
+// writes product chain "expression" to memory starting at "destination" with leading dimension "ld",
+// factors are multiplied in the cheapest order (defined in matrix.h)
+template<typename T1, typename T2, typename E2>
+void evaluate_chain(const MatrixExpression<T2, E2> &expression, T1 *destination, std::size_t ld);
+
+// policy of product for operands which don't lie in memory
+enum class Materialization {
+    automatic,  // operand is evaluated into temporary if the cost model finds it cheaper (see Product::materializes_lhs)
+    always,     // operand is always evaluated into temporary
+    never       // elements of operand are evaluated every time they are read
+};
+
 // class of product operation
 // T - type of elements of matrix obtained by evaluating product of the expressions
 // E1, E2 - types of expressions for product
@@ -99,6 +223,15 @@ protected:
     std::conditional_t<E1::has_data, const E1&, E1> first;
     std::conditional_t<E2::has_data, const E2&, E2> second;
 
+    Materialization materialization;
+
+    // operands evaluated by prepare, empty if operand is read directly
+    mutable ScratchBuffer<typename E1::value_type> first_value;
+    mutable ScratchBuffer<typename E2::value_type> second_value;
+
+    // whole product evaluated by prepare if product is chain of products (see is_product_chain), held until release
+    mutable ScratchBuffer<T> value;
+
 public:
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating product of the expressions
     T operator[](std::size_t i, std::size_t j) const;
@@ -107,10 +240,53 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating product of the expressions may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // returns estimated cost of one element, materialized operands cost nothing.
+    // chain of products is evaluated by prepare, its elements cost nothing
+    std::size_t cost() const;
+
+    // every element of the first operand is read m() times, every element of the second one is read n() times.
+    // operand which doesn't lie in memory is materialized by automatic policy if reading its elements that many times
+    // costs more than evaluating them once and writing to temporary: reads * cost > cost + 1
+    bool materializes_lhs() const;
+    bool materializes_rhs() const;
+
+    // overrides policy of the cost model for operands of this product
+    Product& set_materialization(Materialization materialization);
+
+    // evaluates operands chosen by materializes_lhs/materializes_rhs into temporaries from scratch pool,
+    // prepares the rest. Chain of products is evaluated as a whole by evaluate_chain instead.
+    // Temporaries are held until release, elements are read from them only while evaluation lasts
+    void prepare() const;
+
+    // returns temporaries to scratch pool and releases operands
+    void release() const;
+
+    // return true if operand lies in memory or was materialized by prepare
+    bool lhs_in_memory() const;
+    bool rhs_in_memory() const;
+
+    // return description of memory of operands, available if lhs_in_memory/rhs_in_memory
+    StorageView<typename E1::value_type> lhs_view() const;
+    StorageView<typename E2::value_type> rhs_view() const;
+
+    // return operands of product
+    const E1& lhs() const;
+    const E2& rhs() const;
+
     template<typename T1, typename T2>
     Product(const MatrixExpression<T1, E1> &first, const MatrixExpression<T2, E2> &second);
 };
 
+// is_product<E>::value equals true if E is Product
+template<typename E>
+struct is_product : std::false_type {};
+
+template<typename T, typename E1, typename E2>
+struct is_product<Product<T, E1, E2>> : std::true_type {};
+
 // class of product of matrix and scalar
 // T - type of elements of matrix obtained by evaluating product of the expression and scalar
 // E - type of expression for product
@@ -121,6 +297,9 @@ protected:
     std::conditional_t<E::has_data, const E&, E> expression;
     V val;
 public:
+    // product by scalar is evaluated by packets if expression is
+    static constexpr bool has_packets = E::has_packets;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating product of the expression and scalar
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -128,6 +307,22 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating product of the expression and scalar may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare operands for evaluation and release them (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
+    // return multiplied expression and scalar
+    const E& operand() const;
+    V scalar() const;
+
     ScalarProduct(const MatrixExpression<T, E> &expression, V val);
 };
 
@@ -142,6 +337,9 @@ private:
     V val;
 
 public:
+    // division by scalar is evaluated by packets if expression is
+    static constexpr bool has_packets = E::has_packets;
+
     // returns copy of element on i-th row and j-th column of matrix obtained by evaluating division of the expression by scalar
     T operator[](std::size_t i, std::size_t j) const;
 
@@ -149,9 +347,77 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
+    // returns true if evaluating division of the expression by scalar may read memory of "region" (see MatrixExpression::aliases)
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // return estimated cost of one element, prepare operands for evaluation and release them (see MatrixExpression)
+    std::size_t cost() const;
+    void prepare() const;
+    void release() const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
+    // return divided expression and scalar
+    const E& operand() const;
+    V scalar() const;
+
     ScalarDivision(const MatrixExpression<T, E> &expression, V val);
 };
 
+// is_scaling<E>::value equals true if E is negation, product or division by scalar, such expressions provide operand()
+template<typename E>
+struct is_scaling : std::false_type {};
+
+template<typename T, typename E>
+struct is_scaling<Negation<T, E>> : std::true_type {};
+
+template<typename T, typename E, typename V>
+struct is_scaling<ScalarProduct<T, E, V>> : std::true_type {};
+
+template<typename T, typename E, typename V>
+struct is_scaling<ScalarDivision<T, E, V>> : std::true_type {};
+
+// ProductChain<T1, E> describes expression E as chain of factors multiplied by scalar: nested products are flattened,
+// negations, products and divisions by scalar are moved to the scalar.
+// length - count of factors, scaled - true if there is a scalar,
+// uniform - true if all factors and scalars have elements of type T1
+template<typename T1, typename E>
+struct ProductChain {
+    static constexpr std::size_t length = 1;
+    static constexpr bool scaled = false;
+    static constexpr bool uniform = std::is_same_v<typename E::value_type, T1>;
+};
+
+template<typename T1, typename T, typename E1, typename E2>
+struct ProductChain<T1, Product<T, E1, E2>> {
+    static constexpr std::size_t length = ProductChain<T1, E1>::length + ProductChain<T1, E2>::length;
+    static constexpr bool scaled = ProductChain<T1, E1>::scaled || ProductChain<T1, E2>::scaled;
+    static constexpr bool uniform = std::is_same_v<T, T1> && ProductChain<T1, E1>::uniform && ProductChain<T1, E2>::uniform;
+};
+
+template<typename T1, typename T, typename E>
+struct ProductChain<T1, Negation<T, E>> {
+    static constexpr std::size_t length = ProductChain<T1, E>::length;
+    static constexpr bool scaled = true;
+    static constexpr bool uniform = std::is_same_v<T, T1> && ProductChain<T1, E>::uniform;
+};
+
+template<typename T1, typename T, typename E, typename V>
+struct ProductChain<T1, ScalarProduct<T, E, V>> {
+    static constexpr std::size_t length = ProductChain<T1, E>::length;
+    static constexpr bool scaled = true;
+    static constexpr bool uniform = std::is_same_v<T, T1> && std::is_same_v<V, T1> && ProductChain<T1, E>::uniform;
+};
+
+template<typename T1, typename T, typename E, typename V>
+struct ProductChain<T1, ScalarDivision<T, E, V>> {
+    static constexpr std::size_t length = ProductChain<T1, E>::length;
+    static constexpr bool scaled = true;
+    static constexpr bool uniform = std::is_same_v<T, T1> && std::is_same_v<V, T1> && ProductChain<T1, E>::uniform;
+};
+
 // expression surface-operations functions //
 // NOTE: for reasons of possibility of deduction of return type of surface-operations,
 // those functions can be used only with expressions/scalars with a same value_type
@@ -177,9 +443,5 @@ ScalarProduct<T, E, T> operator*(T val, const MatrixExpression<T, E> &expression
 template<typename T, typename E>
 ScalarDivision<T, E, T> operator/(const MatrixExpression<T, E> &expression, T val);
 
-// output function //
-template<typename T, typename E>
-std::ostream& operator<<(std::ostream &ostream, const MatrixExpression<T, E> &expression);
-
 #include "matrix-expression.tpp"
 #endif //MATRIX_CALCULATOR_MATRIXEXPRESSION_H
@@ -1,4 +1,36 @@
-#include <iomanip>
+// MemoryRegion implementation //
+
+inline bool MemoryRegion::overlaps(const MemoryRegion &other) const {
+    if (n == 0 || row_size == 0 || other.n == 0 || other.row_size == 0) {
+        return false;
+    }
+
+    std::uintptr_t end = begin + (n - 1) * row_stride + row_size;
+    std::uintptr_t other_end = other.begin + (other.n - 1) * other.row_stride + other.row_size;
+    if (end <= other.begin || other_end <= begin) {
+        return false;
+    }
+
+    // regions with different strides are compared by their bounds only
+    if (row_stride != other.row_stride || row_size > row_stride || other.row_size > row_stride) {
+        return true;
+    }
+
+    // position of the first byte of "other" relative to this region: row q, byte r of the row
+    std::ptrdiff_t offset = std::ptrdiff_t(other.begin - begin);
+    std::ptrdiff_t stride = std::ptrdiff_t(row_stride);
+    std::ptrdiff_t q = (offset >= 0 ? offset / stride : -((-offset + stride - 1) / stride));
+    std::size_t r = std::size_t(offset - q * stride);
+    std::ptrdiff_t rows = std::ptrdiff_t(n);
+    std::ptrdiff_t other_rows = std::ptrdiff_t(other.n);
+
+    // rows of "other" start inside rows q, q+1, ... of this region
+    if (r < row_size && q < rows && q + other_rows > 0) {
+        return true;
+    }
+    // rows of "other" which don't fit into the rest of a row continue at the start of the next one
+    return r + other.row_size > row_stride && q + 1 < rows && q + 1 + other_rows > 0;
+}
 
 // MatrixExpression implementation //
 
@@ -17,6 +49,22 @@ std::size_t MatrixExpression<T, E>::m() const {
     return static_cast<const E&>(*this).m();
 }
 
+template<typename T, typename E>
+bool MatrixExpression<T, E>::aliases(const MemoryRegion&, bool) const {
+    return true;
+}
+
+template<typename T, typename E>
+std::size_t MatrixExpression<T, E>::cost() const {
+    return 0;
+}
+
+template<typename T, typename E>
+void MatrixExpression<T, E>::prepare() const {}
+
+template<typename T, typename E>
+void MatrixExpression<T, E>::release() const {}
+
 // matrices compatibility functions //
 
 template<typename T1, typename E1, typename T2, typename E2>
@@ -57,6 +105,38 @@ std::size_t Negation<T, E>::m() const {
     return expression.m();
 }
 
+template<typename T, typename E>
+bool Negation<T, E>::aliases(const MemoryRegion &region, bool aligned) const {
+    return expression.aliases(region, aligned);
+}
+
+template<typename T, typename E>
+std::size_t Negation<T, E>::cost() const {
+    return expression.cost() + 1;
+}
+
+template<typename T, typename E>
+void Negation<T, E>::prepare() const {
+    expression.prepare();
+}
+
+template<typename T, typename E>
+void Negation<T, E>::release() const {
+    expression.release();
+}
+
+template<typename T, typename E>
+template<typename P>
+void Negation<T, E>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    expression.load_packet(packet, i, j);
+    packet = -packet;
+}
+
+template<typename T, typename E>
+const E& Negation<T, E>::operand() const {
+    return expression;
+}
+
 template<typename T, typename E>
 Negation<T, E>::Negation(const MatrixExpression<T, E>& expression_) : expression(static_cast<const E&>(expression_)) {}
 
@@ -77,6 +157,37 @@ std::size_t Summation<T, E1, E2>::m() const {
     return second.m();
 }
 
+template<typename T, typename E1, typename E2>
+bool Summation<T, E1, E2>::aliases(const MemoryRegion &region, bool aligned) const {
+    return first.aliases(region, aligned) || second.aliases(region, aligned);
+}
+
+template<typename T, typename E1, typename E2>
+std::size_t Summation<T, E1, E2>::cost() const {
+    return first.cost() + second.cost() + 1;
+}
+
+template<typename T, typename E1, typename E2>
+void Summation<T, E1, E2>::prepare() const {
+    first.prepare();
+    second.prepare();
+}
+
+template<typename T, typename E1, typename E2>
+void Summation<T, E1, E2>::release() const {
+    first.release();
+    second.release();
+}
+
+template<typename T, typename E1, typename E2>
+template<typename P>
+void Summation<T, E1, E2>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    P second_packet;
+    first.load_packet(packet, i, j);
+    second.load_packet(second_packet, i, j);
+    packet += second_packet;
+}
+
 template<typename T, typename E1, typename E2>
 template<typename T1, typename T2>
 Summation<T, E1, E2>::Summation(const MatrixExpression<T1, E1> &first_, const MatrixExpression<T2, E2> &second_) :
@@ -102,6 +213,37 @@ std::size_t Subtraction<T, E1, E2>::m() const {
     return second.m();
 }
 
+template<typename T, typename E1, typename E2>
+bool Subtraction<T, E1, E2>::aliases(const MemoryRegion &region, bool aligned) const {
+    return first.aliases(region, aligned) || second.aliases(region, aligned);
+}
+
+template<typename T, typename E1, typename E2>
+std::size_t Subtraction<T, E1, E2>::cost() const {
+    return first.cost() + second.cost() + 1;
+}
+
+template<typename T, typename E1, typename E2>
+void Subtraction<T, E1, E2>::prepare() const {
+    first.prepare();
+    second.prepare();
+}
+
+template<typename T, typename E1, typename E2>
+void Subtraction<T, E1, E2>::release() const {
+    first.release();
+    second.release();
+}
+
+template<typename T, typename E1, typename E2>
+template<typename P>
+void Subtraction<T, E1, E2>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    P second_packet;
+    first.load_packet(packet, i, j);
+    second.load_packet(second_packet, i, j);
+    packet -= second_packet;
+}
+
 template<typename T, typename E1, typename E2>
 template<typename T1, typename T2>
 Subtraction<T, E1, E2>::Subtraction(const MatrixExpression<T1, E1> &first_, const MatrixExpression<T2, E2> &second_) :
@@ -110,13 +252,65 @@ first(static_cast<const E1&>(first_)), second(static_cast<const E2&>(second_)) {
     check_m(first, second);
 }
 
+// product chain functions implementation //
+
+template<typename T1, typename E>
+constexpr bool is_product_chain() {
+    using Chain = ProductChain<T1, E>;
+    return Chain::uniform && Chain::length >= 2 && (Chain::length >= 3 || Chain::scaled);
+}
+
+// returns true if factor of product chain lying in memory overlaps "region", other factors are evaluated before writing
+template<typename E>
+bool chain_aliases(const E &expression, const MemoryRegion &region) {
+    if constexpr (is_product<E>::value) {
+        return chain_aliases(expression.lhs(), region) || chain_aliases(expression.rhs(), region);
+    }
+    else if constexpr (is_scaling<E>::value) {
+        return chain_aliases(expression.operand(), region);
+    }
+    else if constexpr (E::has_storage) {
+        return expression.aliases(region, false);
+    }
+    else {
+        return false;
+    }
+}
+
 // Product implementation //
 
 template<typename T, typename E1, typename E2>
 T Product<T, E1, E2>::operator[](std::size_t i, std::size_t j) const {
+    if (value.data() != nullptr) {
+        return value.data()[i * m() + j];
+    }
+
+    // materialized operands are read from temporaries
+    const auto *first_data = first_value.data();
+    const auto *second_data = second_value.data();
+    std::size_t K = first.m();
+    std::size_t M = second.m();
+
     T result = T(0);
-    for (int k = 0; k < first.m(); ++k) {
-        result += first[i, k] * second[k, j];
+    if (first_data != nullptr && second_data != nullptr) {
+        for (std::size_t k = 0; k < K; ++k) {
+            result += first_data[i * K + k] * second_data[k * M + j];
+        }
+    }
+    else if (first_data != nullptr) {
+        for (std::size_t k = 0; k < K; ++k) {
+            result += first_data[i * K + k] * second[k, j];
+        }
+    }
+    else if (second_data != nullptr) {
+        for (std::size_t k = 0; k < K; ++k) {
+            result += first[i, k] * second_data[k * M + j];
+        }
+    }
+    else {
+        for (std::size_t k = 0; k < K; ++k) {
+            result += first[i, k] * second[k, j];
+        }
     }
     return result;
 }
@@ -131,10 +325,145 @@ std::size_t Product<T, E1, E2>::m() const {
     return second.m();
 }
 
+template<typename T, typename E1, typename E2>
+bool Product<T, E1, E2>::aliases(const MemoryRegion &region, bool) const {
+    if constexpr (is_product_chain<T, Product>()) {
+        return chain_aliases(*this, region);
+    }
+
+    // every element of product reads whole row of the first and whole column of the second expression.
+    // materialized operands are read by prepare before anything is written
+    return (!materializes_lhs() && first.aliases(region, false)) || (!materializes_rhs() && second.aliases(region, false));
+}
+
+template<typename T, typename E1, typename E2>
+std::size_t Product<T, E1, E2>::cost() const {
+    if constexpr (is_product_chain<T, Product>()) {
+        return 0;
+    }
+
+    std::size_t first_cost = (materializes_lhs() ? 0 : first.cost());
+    std::size_t second_cost = (materializes_rhs() ? 0 : second.cost());
+    return first.m() * (first_cost + second_cost + 2);
+}
+
+// returns true if operand read "reads" times per element is materialized under "materialization"
+template<typename E>
+bool materializes_operand(const E &operand, std::size_t reads, Materialization materialization) {
+    if constexpr (E::has_storage) {
+        return false;
+    }
+    else {
+        switch (materialization) {
+            case Materialization::always:
+                return true;
+            case Materialization::never:
+                return false;
+            default:
+                std::size_t cost = operand.cost();
+                return reads * cost > cost + 1;
+        }
+    }
+}
+
+template<typename T, typename E1, typename E2>
+bool Product<T, E1, E2>::materializes_lhs() const {
+    return materializes_operand(first, second.m(), materialization);
+}
+
+template<typename T, typename E1, typename E2>
+bool Product<T, E1, E2>::materializes_rhs() const {
+    return materializes_operand(second, first.n(), materialization);
+}
+
+template<typename T, typename E1, typename E2>
+Product<T, E1, E2>& Product<T, E1, E2>::set_materialization(Materialization materialization_) {
+    materialization = materialization_;
+    return *this;
+}
+
+template<typename T, typename E1, typename E2>
+void Product<T, E1, E2>::prepare() const {
+    if constexpr (is_product_chain<T, Product>()) {
+        value.resize(n() * m());
+        evaluate_chain(*this, value.data(), m());
+        return;
+    }
+
+    // evaluate prepares operand itself
+    if (materializes_lhs()) {
+        first_value.resize(first.n() * first.m());
+        evaluate(first, first_value.data(), first.m());
+    }
+    else {
+        first_value.clear();
+        first.prepare();
+    }
+
+    if (materializes_rhs()) {
+        second_value.resize(second.n() * second.m());
+        evaluate(second, second_value.data(), second.m());
+    }
+    else {
+        second_value.clear();
+        second.prepare();
+    }
+}
+
+template<typename T, typename E1, typename E2>
+void Product<T, E1, E2>::release() const {
+    value.clear();
+    first_value.clear();
+    second_value.clear();
+    first.release();
+    second.release();
+}
+
+template<typename T, typename E1, typename E2>
+bool Product<T, E1, E2>::lhs_in_memory() const {
+    return E1::has_storage || first_value.data() != nullptr;
+}
+
+template<typename T, typename E1, typename E2>
+bool Product<T, E1, E2>::rhs_in_memory() const {
+    return E2::has_storage || second_value.data() != nullptr;
+}
+
+template<typename T, typename E1, typename E2>
+StorageView<typename E1::value_type> Product<T, E1, E2>::lhs_view() const {
+    if constexpr (E1::has_storage) {
+        return first.view();
+    }
+    else {
+        return StorageView<typename E1::value_type>{first_value.data(), first.m(), 1, false};
+    }
+}
+
+template<typename T, typename E1, typename E2>
+StorageView<typename E2::value_type> Product<T, E1, E2>::rhs_view() const {
+    if constexpr (E2::has_storage) {
+        return second.view();
+    }
+    else {
+        return StorageView<typename E2::value_type>{second_value.data(), second.m(), 1, false};
+    }
+}
+
+template<typename T, typename E1, typename E2>
+const E1& Product<T, E1, E2>::lhs() const {
+    return first;
+}
+
+template<typename T, typename E1, typename E2>
+const E2& Product<T, E1, E2>::rhs() const {
+    return second;
+}
+
 template<typename T, typename E1, typename E2>
 template<typename T1, typename T2>
 Product<T, E1, E2>::Product(const MatrixExpression<T1, E1> &first_, const MatrixExpression<T2, E2> &second_) :
-first(static_cast<const E1&>(first_)), second(static_cast<const E2&>(second_)) {
+first(static_cast<const E1&>(first_)), second(static_cast<const E2&>(second_)),
+materialization(Materialization::automatic) {
     check_mn(first, second);
 }
 
@@ -155,6 +484,48 @@ std::size_t ScalarProduct<T, E, V>::m() const {
     return expression.m();
 }
 
+template<typename T, typename E, typename V>
+bool ScalarProduct<T, E, V>::aliases(const MemoryRegion &region, bool aligned) const {
+    return expression.aliases(region, aligned);
+}
+
+template<typename T, typename E, typename V>
+std::size_t ScalarProduct<T, E, V>::cost() const {
+    return expression.cost() + 1;
+}
+
+template<typename T, typename E, typename V>
+void ScalarProduct<T, E, V>::prepare() const {
+    expression.prepare();
+}
+
+template<typename T, typename E, typename V>
+void ScalarProduct<T, E, V>::release() const {
+    expression.release();
+}
+
+template<typename T, typename E, typename V>
+template<typename P>
+void ScalarProduct<T, E, V>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    expression.load_packet(packet, i, j);
+    if constexpr (PacketTraits<V>::vectorizable && PacketTraits<V>::complex) {
+        complex_scale(packet, val);
+    }
+    else {
+        packet *= typename PacketTraits<T>::real_type(val);
+    }
+}
+
+template<typename T, typename E, typename V>
+const E& ScalarProduct<T, E, V>::operand() const {
+    return expression;
+}
+
+template<typename T, typename E, typename V>
+V ScalarProduct<T, E, V>::scalar() const {
+    return val;
+}
+
 template<typename T, typename E, typename V>
 ScalarProduct<T, E, V>::ScalarProduct(const MatrixExpression<T, E> &expression_, V val_) :
 expression(static_cast<const E&>(expression_)), val(val_) {}
@@ -163,6 +534,12 @@ expression(static_cast<const E&>(expression_)), val(val_) {}
 
 template<typename T, typename E, typename V>
 T ScalarDivision<T, E, V>::operator[](std::size_t i, std::size_t j) const {
+    // complex packets are multiplied by reciprocal, so elements outside of packets are computed the same way
+    if constexpr (PacketTraits<V>::vectorizable) {
+        if constexpr (PacketTraits<V>::complex) {
+            return expression[i, j] * (V(1) / val);
+        }
+    }
     return expression[i, j] / val;
 }
 
@@ -176,6 +553,48 @@ std::size_t ScalarDivision<T, E, V>::m() const {
     return expression.m();
 }
 
+template<typename T, typename E, typename V>
+bool ScalarDivision<T, E, V>::aliases(const MemoryRegion &region, bool aligned) const {
+    return expression.aliases(region, aligned);
+}
+
+template<typename T, typename E, typename V>
+std::size_t ScalarDivision<T, E, V>::cost() const {
+    return expression.cost() + 1;
+}
+
+template<typename T, typename E, typename V>
+void ScalarDivision<T, E, V>::prepare() const {
+    expression.prepare();
+}
+
+template<typename T, typename E, typename V>
+void ScalarDivision<T, E, V>::release() const {
+    expression.release();
+}
+
+template<typename T, typename E, typename V>
+template<typename P>
+void ScalarDivision<T, E, V>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    expression.load_packet(packet, i, j);
+    if constexpr (PacketTraits<V>::vectorizable && PacketTraits<V>::complex) {
+        complex_scale(packet, V(1) / val);
+    }
+    else {
+        packet /= typename PacketTraits<T>::real_type(val);
+    }
+}
+
+template<typename T, typename E, typename V>
+const E& ScalarDivision<T, E, V>::operand() const {
+    return expression;
+}
+
+template<typename T, typename E, typename V>
+V ScalarDivision<T, E, V>::scalar() const {
+    return val;
+}
+
 template<typename T, typename E, typename V>
 ScalarDivision<T, E, V>::ScalarDivision(const MatrixExpression<T, E> &expression_, V val_) :
 expression(static_cast<const E&>(expression_)), val(val_) {}
@@ -216,38 +635,3 @@ template<typename T, typename E>
 ScalarDivision<T, E, T> operator/(const MatrixExpression<T, E> &expression, T val) {
     return ScalarDivision<T, E, T>(expression, val);
 }
-
-// output function implementation //
-
-template<typename T>
-std::size_t number_length(T num) {
-    std::stringstream ss;
-    ss << num;
-    return ss.str().length();
-}
-
-template<typename T, typename E>
-std::ostream& operator<<(std::ostream &ostream, const MatrixExpression<T, E> &expression) {
-    if (expression.n() > 0) {
-        std::vector<std::size_t> columns_lengths = std::vector<std::size_t>(expression.m());
-        for (int j = 0; j < expression.m(); ++j) {
-            for (int i = 0; i < expression.n(); ++i) {
-                std::size_t element_length = number_length(expression[i, j]);
-                if (element_length > columns_lengths[j]) {
-                    columns_lengths[j] = element_length;
-                }
-            }
-        }
-
-        for (int j = 0; j < expression.m(); ++j) {
-            ostream << std::setw(columns_lengths[j] + 3) << std::left << expression[0, j];
-        }
-        for (int i = 1; i < expression.n(); ++i) {
-            ostream << '\n';
-            for (int j = 0; j < expression.m(); ++j) {
-                ostream << std::setw(columns_lengths[j] + 3) << std::left << expression[i, j];
-            }
-        }
-    }
-    return ostream;
-}
\ No newline at end of file
@@ -1,6 +1,16 @@
 #include <iostream>
 #include <fstream>
+#include <cmath>
+#include <complex>
+#include <array>
+#include <memory_resource>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <string>
 #include "matrix.h"
+#include "fixed-matrix/fixed-matrix.h"
+#include "binary-format/binary-format.h"
 
 void ConstSubmatrix_test() {
     std::cout << "ConstSubmatrix test";
@@ -13,18 +23,20 @@ void ConstSubmatrix_test() {
         }
     }
 
+    const auto matrix = Matrix<double>(data);
+
     std::cout << "matrix:" << '\n';
-    std::cout << ConstSubmatrix(data);
+    std::cout << matrix[Slice(0, matrix.n())];
 
     std::cout << '\n' << '\n';
 
     std::cout << "matrix[2:7]:" << '\n';
-    std::cout << ConstSubmatrix(data, Slice(2,7));
+    std::cout << matrix[Slice(2,7)];
 
     std::cout << '\n' << '\n';
 
     std::cout << "matrix[3:8, 0:4]:" << '\n';
-    std::cout << ConstSubmatrix(data, Slice(3,8), Slice(0,4));
+    std::cout << matrix[Slice(3,8), Slice(0,4)];
 }
 
 void arithmetic_test() {
@@ -38,12 +50,14 @@ void arithmetic_test() {
         }
     }
 
+    const auto matrix = Matrix<double>(data);
+
     std::cout << "m1:" << '\n';
-    auto m1 = ConstSubmatrix(data, Slice(0,5));
+    auto m1 = matrix[Slice(0,5)];
     std::cout << m1;
     std::cout << '\n' << '\n';
     std::cout << "m2:" << '\n';
-    auto m2 = ConstSubmatrix(data, Slice(5,10));
+    auto m2 = matrix[Slice(5,10)];
     std::cout << m2;
     std::cout << '\n' << '\n';
     std::cout << "-m1:" << '\n';
@@ -79,15 +93,15 @@ void Submatrix_test() {
         }
     }
 
-    auto matrix = Submatrix(data);
+    auto matrix = Matrix<double>(data);
     std::cout << "matrix:" << '\n';
     std::cout << matrix;
     std::cout << '\n' << '\n';
-    Submatrix(data, Slice(1,7)) += Submatrix(data, Slice(3,9));
+    matrix[Slice(1,7)] += matrix[Slice(3,9)];
     std::cout << "matrix[1:7] += matrix[3:9]:" <<'\n';
     std::cout << matrix;
     std::cout <<'\n' << '\n';
-    Submatrix(data, Slice(0, matrix.n()), Slice(2,5)) -= Submatrix(data, Slice(0, matrix.n()), Slice(0,3));
+    matrix[Slice(0, matrix.n()), Slice(2,5)] -= matrix[Slice(0, matrix.n()), Slice(0,3)];
     std::cout << "matrix[:, 2:5] -= matrix[:, 0:3]:" << '\n';
     std::cout << matrix;
 }
@@ -122,6 +136,568 @@ void Matrix_test() {
     std::cout << square_matrix;
 }
 
+void gemm_test() {
+    std::cout << "GEMM test";
+    std::cout << '\n' << '\n';
+
+    auto first = Matrix<double>(100, 120);
+    for (std::size_t i = 0; i < first.n(); ++i) {
+        for (std::size_t j = 0; j < first.m(); ++j) {
+            first[i, j] = double((i * 7 + j * 3) % 11) - 5;
+        }
+    }
+    auto second = Matrix<double>(120, 90);
+    for (std::size_t i = 0; i < second.n(); ++i) {
+        for (std::size_t j = 0; j < second.m(); ++j) {
+            second[i, j] = double((i * 5 + j * 2) % 13) - 6;
+        }
+    }
+
+    // product assigned to matrix is computed by GEMM, element access of product is computed element-wise
+    Matrix<double> product = first * second;
+    Matrix<double> submatrix_product = first[Slice(10, 60), Slice(0, 30)] * second[Slice(30, 60), Slice(5, 85)];
+
+    double difference = 0;
+    double submatrix_difference = 0;
+    for (std::size_t i = 0; i < product.n(); ++i) {
+        for (std::size_t j = 0; j < product.m(); ++j) {
+            difference = std::max(difference, std::abs(product[i, j] - (first * second)[i, j]));
+        }
+    }
+    for (std::size_t i = 0; i < submatrix_product.n(); ++i) {
+        for (std::size_t j = 0; j < submatrix_product.m(); ++j) {
+            submatrix_difference = std::max(submatrix_difference, std::abs(submatrix_product[i, j] -
+                (first[Slice(10, 60), Slice(0, 30)] * second[Slice(30, 60), Slice(5, 85)])[i, j]));
+        }
+    }
+
+    std::cout << "max difference between GEMM and element-wise product:" << '\n';
+    std::cout << difference;
+    std::cout << '\n' << '\n';
+    std::cout << "max difference between GEMM and element-wise product of submatrices:" << '\n';
+    std::cout << submatrix_difference;
+}
+
+void simd_test() {
+    std::cout << "SIMD evaluation test";
+    std::cout << '\n' << '\n';
+
+    auto first = Matrix<std::complex<double>>(30, 37);
+    auto second = Matrix<std::complex<double>>(30, 37);
+    for (std::size_t i = 0; i < first.n(); ++i) {
+        for (std::size_t j = 0; j < first.m(); ++j) {
+            first[i, j] = std::complex<double>(double(i) - 0.5 * j, 0.25 * i * j);
+            second[i, j] = std::complex<double>(double(j) / (i + 1), -double(i));
+        }
+    }
+    auto expression = -(first[Slice(0, 30)] * std::complex<double>(1.5, -2) - second[Slice(0, 30)] / std::complex<double>(0.5, 3));
+
+    // evaluates the same expression element by element and by packets of the widest instruction set
+    SimdLevel level = simd_level();
+    set_simd_level(SimdLevel::scalar);
+    Matrix<std::complex<double>> scalar_result = expression;
+    set_simd_level(level);
+    Matrix<std::complex<double>> packet_result = expression;
+
+    double difference = 0;
+    for (std::size_t i = 0; i < scalar_result.n(); ++i) {
+        for (std::size_t j = 0; j < scalar_result.m(); ++j) {
+            difference = std::max(difference, std::abs(scalar_result[i, j] - packet_result[i, j]));
+        }
+    }
+    std::cout << "max difference between element-wise and packet evaluation:" << '\n';
+    std::cout << difference;
+}
+
+void alias_test() {
+    std::cout << "alias test";
+    std::cout << '\n' << '\n';
+
+    auto data = std::vector<std::vector<double>>(4, std::vector<double>(4));
+    for (int i = 0; i < data.size(); ++i) {
+        for (int j = 0; j < data[0].size(); ++j) {
+            data[i][j] = j + i * data[0].size();
+        }
+    }
+    auto matrix = Matrix<double>(data);
+    std::cout << "matrix:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    // product reads the submatrix it is assigned to, so it is evaluated into temporary matrix
+    Matrix<double> expected = matrix[Slice(1, 4), Slice(1, 4)] * matrix[Slice(0, 3), Slice(0, 3)];
+    matrix[Slice(0, 3), Slice(0, 3)] = matrix[Slice(1, 4), Slice(1, 4)] * matrix[Slice(0, 3), Slice(0, 3)];
+    std::cout << "matrix[0:3, 0:3] = matrix[1:4, 1:4] * matrix[0:3, 0:3]:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+    std::cout << "expected matrix[0:3, 0:3]:" << '\n';
+    std::cout << expected;
+    std::cout << '\n' << '\n';
+
+    // columns 0 and 2 don't share memory, so the expression is written directly
+    matrix[Slice(0, 4), 0] += matrix[Slice(0, 4), 2] * 2.0;
+    std::cout << "matrix[:, 0] += matrix[:, 2] * 2:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    auto result = Matrix<double>(4);
+    result.noalias() = matrix * matrix;
+    result.noalias() -= matrix;
+    std::cout << "result = matrix * matrix - matrix (no alias):" << '\n';
+    std::cout << result;
+}
+
+void compound_assignment_test() {
+    std::cout << "compound assignment test";
+    std::cout << '\n' << '\n';
+
+    auto data = std::vector<std::vector<double>>(3, std::vector<double>(3));
+    for (int i = 0; i < data.size(); ++i) {
+        for (int j = 0; j < data[0].size(); ++j) {
+            data[i][j] = j + i * data[0].size();
+        }
+    }
+    auto matrix = Matrix<double>(data);
+    const double *buffer = matrix.data();
+
+    // compound assignment updates elements in place
+    matrix += matrix * 2.0;
+    matrix -= matrix / 3.0;
+    matrix *= 0.5;
+    matrix /= 2.0;
+    std::cout << "((matrix + matrix * 2) * 2/3) / 4:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+    std::cout << "buffer reused:" << '\n';
+    std::cout << (matrix.data() == buffer);
+    std::cout << '\n' << '\n';
+
+    Matrix<double> moved = std::move(matrix);
+    std::cout << "size of moved-from matrix:" << '\n';
+    std::cout << matrix.n() << ' ' << matrix.m();
+    std::cout << '\n' << '\n';
+    std::cout << "buffer moved:" << '\n';
+    std::cout << (moved.data() == buffer);
+}
+
+void FixedMatrix_test() {
+    std::cout << "FixedMatrix test";
+    std::cout << '\n' << '\n';
+
+    // fixed-size matrices can be built and multiplied at compile time
+    constexpr auto rotation = FixedMatrix<double, 2, 2>{0, -1,
+                                                        1, 0};
+    constexpr auto vector = FixedMatrix<double, 2, 1>{1, 2};
+    constexpr auto rotated = rotation * vector;
+    static_assert(rotated[0, 0] == -2 && rotated[1, 0] == 1);
+
+    std::cout << "rotation * vector:" << '\n';
+    std::cout << rotated;
+    std::cout << '\n' << '\n';
+
+    auto matrix = FixedMatrix<double, 3, 3>{1, 2, 3,
+                                            4, 5, 6,
+                                            7, 8, 9};
+    matrix += matrix;
+    matrix -= FixedMatrix<double, 3, 3>{1, 1, 1,
+                                        1, 1, 1,
+                                        1, 1, 1};
+    matrix /= 2;
+    std::cout << "(matrix + matrix - 1) / 2:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    // fixed-size matrix takes part in expressions with other matrices
+    auto dynamic = Matrix<double>(3, 1);
+    dynamic[0, 0] = 1;
+    dynamic[2, 0] = -1;
+    std::cout << "matrix * dynamic + dynamic:" << '\n';
+    std::cout << matrix * dynamic + dynamic;
+    std::cout << '\n' << '\n';
+
+    matrix[Slice(0, 2), Slice(0, 2)] = rotation;
+    std::cout << "matrix with rotation in top-left corner:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    // assignment of expression reading the matrix itself
+    matrix = matrix * matrix;
+    std::cout << "matrix * matrix:" << '\n';
+    std::cout << matrix;
+}
+
+void materialization_test() {
+    std::cout << "materialization test";
+    std::cout << '\n' << '\n';
+
+    auto data = std::vector<std::vector<double>>(3, std::vector<double>(3));
+    for (int i = 0; i < data.size(); ++i) {
+        for (int j = 0; j < data[0].size(); ++j) {
+            data[i][j] = j + i * data[0].size();
+        }
+    }
+    auto matrix = Matrix<double>(data);
+    auto vector = Matrix<double>(std::vector<std::vector<double>>{{1}, {0}, {-1}});
+
+    // inner expression is evaluated once instead of once per element of outer product
+    auto product = matrix * (matrix + matrix * matrix);
+    std::cout << "cost of element of matrix * (matrix + matrix * matrix):" << '\n';
+    std::cout << product.cost();
+    std::cout << '\n' << '\n';
+    std::cout << "materializes lhs, rhs:" << '\n';
+    std::cout << product.materializes_lhs() << ' ' << product.materializes_rhs();
+    std::cout << '\n' << '\n';
+    std::cout << "matrix * (matrix + matrix * matrix):" << '\n';
+    std::cout << Matrix<double>(product);
+    std::cout << '\n' << '\n';
+
+    // temporaries are released after evaluation, so elements read later see changed operands
+    auto changed = matrix;
+    auto changed_product = matrix * (changed + changed * changed);
+    auto evaluated = Matrix<double>(changed_product);
+    changed[1, 0] = 1e6;
+    std::cout << "element of evaluated product after change of operand equals fresh product:" << '\n';
+    std::cout << (changed_product[2, 0] == Matrix<double>(matrix * (changed + changed * changed))[2, 0]);
+    std::cout << ' ' << (changed_product[2, 0] != evaluated[2, 0]);
+    std::cout << '\n' << '\n';
+
+    // elements of operand multiplied by vector are read once, it isn't worth materializing
+    auto matrix_vector = (matrix - matrix * 2.0) * vector;
+    std::cout << "materializes lhs of (matrix - matrix * 2) * vector:" << '\n';
+    std::cout << matrix_vector.materializes_lhs();
+    std::cout << '\n' << '\n';
+
+    // policy of the cost model is overridden for single product
+    auto lazy = (matrix - matrix * 2.0) * matrix;
+    lazy.set_materialization(Materialization::never);
+    std::cout << "materializes lhs of (matrix - matrix * 2) * matrix with policy never:" << '\n';
+    std::cout << lazy.materializes_lhs();
+    std::cout << '\n' << '\n';
+    std::cout << "(matrix - matrix * 2) * matrix:" << '\n';
+    std::cout << lazy;
+    std::cout << '\n' << '\n';
+
+    // materialized operand reading destination doesn't need temporary for the result
+    matrix[Slice(0, 3), Slice(0, 1)] -= vector * (matrix[Slice(0, 1), Slice(0, 3)] * vector);
+    std::cout << "matrix[:, 0] -= vector * (matrix[0, :] * vector):" << '\n';
+    std::cout << matrix;
+}
+
+void product_chain_test() {
+    std::cout << "product chain test";
+    std::cout << '\n' << '\n';
+
+    auto data = std::vector<std::vector<double>>(3, std::vector<double>(3));
+    for (int i = 0; i < data.size(); ++i) {
+        for (int j = 0; j < data[0].size(); ++j) {
+            data[i][j] = j + i * data[0].size();
+        }
+    }
+    auto matrix = Matrix<double>(data);
+    auto vector = Matrix<double>(std::vector<std::vector<double>>{{1}, {0}, {-1}});
+    auto row = Matrix<double>(std::vector<std::vector<double>>{{1, 2, 3}});
+
+    // factors and their cheapest order
+    auto factors = std::array<ChainFactor<double>, 4>{ChainFactor<double>{matrix.view(), 3, 3},
+                                                      ChainFactor<double>{matrix.view(), 3, 3},
+                                                      ChainFactor<double>{vector.view(), 3, 1},
+                                                      ChainFactor<double>{row.view(), 1, 3}};
+    auto split = std::array<std::size_t, 16>();
+    std::cout << "multiplications of matrix * matrix * vector * row:" << '\n';
+    std::cout << chain_order(factors, split);
+    std::cout << '\n' << '\n';
+    std::cout << "first split of matrix * matrix * vector * row:" << '\n';
+    std::cout << split[3];
+    std::cout << '\n' << '\n';
+
+    // matrix * matrix is never computed, scalars are applied once to the result
+    std::cout << "2 * matrix * -(matrix * vector) / 4:" << '\n';
+    std::cout << Matrix<double>(2.0 * matrix * -(matrix * vector) / 4.0);
+    std::cout << '\n' << '\n';
+    std::cout << "(matrix * matrix) * vector:" << '\n';
+    std::cout << Matrix<double>((matrix * matrix) * vector);
+    std::cout << '\n' << '\n';
+
+    // chain reading destination
+    matrix = matrix * matrix * matrix;
+    std::cout << "matrix * matrix * matrix:" << '\n';
+    std::cout << matrix;
+    std::cout << '\n' << '\n';
+
+    // chain inside of element-wise expression is evaluated before it
+    std::cout << "vector + matrix * matrix * vector:" << '\n';
+    std::cout << Matrix<double>(vector + matrix * matrix * vector);
+    std::cout << '\n' << '\n';
+
+    // chain evaluated inside of expression isn't kept after evaluation
+    auto sum = vector + matrix * matrix * vector;
+    auto evaluated = Matrix<double>(sum);
+    matrix[0, 0] += 1;
+    std::cout << "element of evaluated chain after change of factor equals fresh chain:" << '\n';
+    std::cout << (sum[0, 0] == Matrix<double>(vector + matrix * matrix * vector)[0, 0]) << ' ' << (sum[0, 0] != evaluated[0, 0]);
+}
+
+void thread_pool_test() {
+    std::cout << "thread pool test";
+    std::cout << '\n' << '\n';
+
+    auto first = Matrix<double>(600, 600);
+    auto second = Matrix<double>(600, 600);
+    for (std::size_t i = 0; i < first.n(); ++i) {
+        for (std::size_t j = 0; j < first.m(); ++j) {
+            first[i, j] = std::sin(double(i + 2 * j));
+            second[i, j] = std::cos(double(3 * i) - j);
+        }
+    }
+
+    // results do not depend on the number of threads taking part in evaluation
+    std::size_t threads = thread_count();
+    set_thread_count(1);
+    Matrix<double> serial_product = first * second;
+    Matrix<double> serial_sum = first * 2.0 - second / 3.0;
+    set_thread_count(4);
+    Matrix<double> parallel_product = first * second;
+    Matrix<double> parallel_sum = first * 2.0 - second / 3.0;
+    set_thread_count(threads);
+
+    bool product_equal = true;
+    bool sum_equal = true;
+    for (std::size_t i = 0; i < first.n(); ++i) {
+        for (std::size_t j = 0; j < first.m(); ++j) {
+            product_equal = product_equal && serial_product[i, j] == parallel_product[i, j];
+            sum_equal = sum_equal && serial_sum[i, j] == parallel_sum[i, j];
+        }
+    }
+    std::cout << "product is the same on 1 and 4 threads:" << '\n';
+    std::cout << product_equal << '\n';
+    std::cout << "element-wise expression is the same on 1 and 4 threads:" << '\n';
+    std::cout << sum_equal;
+}
+
+void resize_test() {
+    std::cout << "resize test";
+    std::cout << '\n' << '\n';
+
+    // shrinking matrix and growing it back to the former size keeps its memory
+    auto matrix = Matrix<double>(40, 40);
+    const double *memory = matrix.data();
+    matrix.resize(3, 5);
+    for (std::size_t i = 0; i < matrix.n(); ++i) {
+        for (std::size_t j = 0; j < matrix.m(); ++j) {
+            matrix[i, j] = double(i * matrix.m() + j);
+        }
+    }
+    std::cout << "size after resize:" << '\n';
+    std::cout << matrix.n() << ' ' << matrix.m() << '\n';
+    std::cout << matrix << '\n';
+    matrix.resize(40, 40);
+    std::cout << "memory is reused:" << '\n';
+    std::cout << (matrix.data() == memory);
+}
+
+void allocator_test() {
+    std::cout << "allocator test";
+    std::cout << '\n' << '\n';
+
+    auto source = Matrix<double>({{1, 2}, {3, 4}});
+
+    // matrices with polymorphic allocator take memory from memory resource
+    auto buffer = std::array<std::byte, 4096>();
+    auto resource = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+    auto pmr_matrix = Matrix<double, std::pmr::polymorphic_allocator<double>>(source * source, &resource);
+    pmr_matrix += source;
+    std::cout << "matrix with polymorphic allocator:" << '\n';
+    std::cout << pmr_matrix << '\n';
+    std::cout << "memory is taken from buffer:" << '\n';
+    std::cout << (reinterpret_cast<std::byte*>(pmr_matrix.data()) >= buffer.data() &&
+                  reinterpret_cast<std::byte*>(pmr_matrix.data()) < buffer.data() + buffer.size()) << '\n';
+
+    // temporaries of assignment which reads its target come from active arena
+    ScratchArena arena;
+    auto matrix = Matrix<double, ScratchAllocator<double>>(source);
+    std::size_t used = arena.used();
+    matrix = matrix * matrix;
+    std::cout << "product evaluated in arena:" << '\n';
+    std::cout << matrix << '\n';
+    std::cout << "memory of temporaries is reused:" << '\n';
+    std::cout << (arena.used() == used) << '\n';
+    {
+        ScratchArena inner;
+        auto temporary = Matrix<double, ScratchAllocator<double>>(100, 100);
+        std::cout << "inner arena is active:" << '\n';
+        std::cout << (ScratchArena::active() == &inner && inner.used() >= 100 * 100 * sizeof(double)) << '\n';
+    }
+    std::cout << "outer arena is restored:" << '\n';
+    std::cout << (ScratchArena::active() == &arena);
+    std::cout << '\n' << '\n';
+
+    // expression evaluated in arena doesn't keep its memory, so its elements are read after the arena is gone
+    auto sum = source * source * source + source;
+    {
+        ScratchArena inner;
+        Matrix<double> evaluated = sum;
+    }
+    std::cout << "element of expression after arena scope:" << '\n';
+    std::cout << sum[1, 0];
+    std::cout << '\n' << '\n';
+
+    // elements of types which aren't trivially copyable are constructed by scratch buffer
+    auto words = ScratchBuffer<std::string>(2);
+    words.data()[0] = "scratch";
+    words.data()[1] = words.data()[0] + " buffer";
+    std::cout << "strings in scratch buffer:" << '\n';
+    std::cout << words.data()[1];
+}
+
+void binary_format_test() {
+    std::cout << "binary format test";
+    std::cout << '\n' << '\n';
+
+    std::string path = (std::filesystem::temp_directory_path() / "matrix-test.bin").string();
+    auto matrix = Matrix<double>({{1, 2, 3}, {4, 5, 6}});
+
+    // mapped file is used by expressions without copy
+    write_binary(path, matrix);
+    {
+        auto mapped = MappedMatrix<double>(path);
+        std::cout << "mapped matrix:" << '\n';
+        std::cout << mapped.view() << '\n';
+        std::cout << "payload is aligned:" << '\n';
+        std::cout << (reinterpret_cast<std::uintptr_t>(mapped.data()) % MATRIX_ALIGNMENT == 0) << '\n';
+        std::cout << "product of mapped submatrix:" << '\n';
+        std::cout << Matrix<double>(mapped[Slice(0, 2), Slice(1, 3)] * mapped[Slice(0, 2), Slice(0, 2)]) << '\n';
+    }
+
+    // changes of copy-on-write mapping don't reach file
+    {
+        auto mapped = MappedMatrix<double>(path, MapMode::copy_on_write);
+        Submatrix<double> changed = mapped.mutable_view();
+        changed *= 10.0;
+        std::cout << "changed copy-on-write mapping:" << '\n';
+        std::cout << mapped.view() << '\n';
+    }
+    std::cout << "file after copy-on-write mapping:" << '\n';
+    std::cout << read_binary<double>(path) << '\n';
+
+    // complex column-major file is read into row-major matrix
+    auto complex_matrix = Matrix<std::complex<double>>({{{1, 1}, {2, -1}}, {{0, 3}, {4, 0}}, {{5, 5}, {6, 0}}});
+    {
+        std::ofstream ostream = std::ofstream(path, std::ios::binary);
+        write_binary(ostream, complex_matrix, Layout::column_major);
+    }
+    std::ifstream istream = std::ifstream(path, std::ios::binary);
+    std::cout << "complex column-major matrix:" << '\n';
+    std::cout << read_binary<std::complex<double>>(istream) << '\n';
+    std::cout << "mapped complex matrix equals original:" << '\n';
+    auto loaded = MappedMatrix<std::complex<double>>(path).load();
+    std::cout << std::equal(loaded.data(), loaded.data() + loaded.n() * loaded.m(), complex_matrix.data()) << '\n';
+
+    // matrix in the middle of stream is read, header which claims more than the stream holds is rejected
+    std::stringstream stream;
+    stream << "prefix";
+    write_binary(stream, matrix);
+    stream.ignore(6);
+    std::cout << "matrix after prefix of stream:" << '\n';
+    std::cout << read_binary<double>(stream) << '\n';
+    std::string bytes = stream.str();
+    BinaryHeader header = binary_header<double>(std::size_t(1) << 40, 3, Layout::row_major, MATRIX_ALIGNMENT);
+    bytes.replace(6, sizeof(BinaryHeader), reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+    std::istringstream truncated = std::istringstream(bytes.substr(6));
+    std::cout << "header larger than stream:" << '\n';
+    try {
+        read_binary<double>(truncated);
+    }
+    catch (const std::invalid_argument &error) {
+        std::cout << error.what() << '\n';
+    }
+
+    // elements of another type are rejected
+    std::cout << "wrong type of elements:" << '\n';
+    try {
+        auto mapped = MappedMatrix<double>(path);
+    }
+    catch (const std::invalid_argument &error) {
+        std::cout << error.what();
+    }
+    std::filesystem::remove(path);
+}
+
+void text_format_test() {
+    std::cout << "text format test";
+    std::cout << '\n' << '\n';
+
+    std::cout << "complex matrix with tuples and plain numbers:" << '\n';
+    std::cout << parse_text<std::complex<double>>("2 2\n(5, 0) (1, -6.5)\n+3 ( 2e1 , 1 )\n") << '\n';
+
+    std::cout << "stream reads one matrix and leaves the rest:" << '\n';
+    std::istringstream istream = std::istringstream("1 3 1.5 -2 3e2\n2 1 7 8");
+    Matrix<double> first, second;
+    istream >> first >> second;
+    std::cout << first << '\n' << second << '\n';
+
+    // long element is read whole by stream, as by parse_text
+    std::string long_text = "1 2\n1." + std::string(130, '0') + " 7";
+    std::istringstream long_istream = std::istringstream(long_text);
+    Matrix<double> long_element;
+    long_istream >> long_element;
+    std::cout << "long element:" << '\n';
+    std::cout << bool(long_istream) << ' ' << long_element << ' ' << parse_text<double>(long_text) << '\n';
+
+    // large text is parsed in parallel by line ranges, with the same result as serial parsing
+    std::string text = "300 300\n";
+    for (std::size_t i = 0; i < 300; ++i) {
+        for (std::size_t j = 0; j < 300; ++j) {
+            text += std::to_string(double(i * 300 + j) / 8) + ' ';
+        }
+        text += '\n';
+    }
+    std::size_t threads = thread_count();
+    set_thread_count(4);
+    Matrix<double> parallel = parse_text<double>(text);
+    set_thread_count(threads);
+    Matrix<double> serial = parse_text<double>(text, false);
+    std::cout << "parallel parsing equals serial:" << '\n';
+    std::cout << std::equal(parallel.data(), parallel.data() + 300 * 300, serial.data()) << '\n';
+
+    // errors point at malformed element
+    std::cout << "errors:" << '\n';
+    for (std::string malformed : {"2 2\n1 2\n3 4x\n", "2 2\n1 2\n3\n", "1 2 (1, 2) (3 4)", "2 1 1 2 3"}) {
+        try {
+            parse_text<std::complex<double>>(malformed);
+        }
+        catch (const ParseError &error) {
+            std::cout << error.what() << '\n';
+        }
+    }
+}
+
+void text_output_test() {
+    std::cout << "text output test";
+    std::cout << '\n' << '\n';
+
+    auto matrix = Matrix<double>({{1.0 / 3, -250}, {1e-7, 42}});
+
+    // flags and precision of stream are respected
+    std::ostringstream fixed;
+    fixed << std::fixed << std::setprecision(2) << matrix;
+    std::cout << "fixed with precision 2:" << '\n';
+    std::cout << fixed.str() << '\n';
+    std::ostringstream signs;
+    signs << std::showpos << matrix * 2.0;
+    std::cout << "expression with shown signs:" << '\n';
+    std::cout << signs.str() << '\n';
+
+    // machine-readable text is read back exactly
+    auto complex_matrix = Matrix<std::complex<double>>({{{0.1, -1.0 / 7}, {1e300, 0}}, {{-2.5, 1e-300}, {3, 4}}});
+    std::ostringstream ostream;
+    write_text(ostream, complex_matrix);
+    std::cout << "machine-readable complex matrix:" << '\n';
+    std::cout << ostream.str();
+    auto read = parse_text<std::complex<double>>(ostream.str());
+    std::cout << "read back exactly:" << '\n';
+    std::cout << std::equal(read.data(), read.data() + read.n() * read.m(), complex_matrix.data());
+}
+
 int main() {
     ConstSubmatrix_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
@@ -130,4 +706,30 @@ int main() {
     Submatrix_test();
     std::cout << "\n\n" << "-----------------" << "\n\n";
     Matrix_test();
-}
\ No newline at end of file
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    gemm_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    simd_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    alias_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    compound_assignment_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    FixedMatrix_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    materialization_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    product_chain_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    thread_pool_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    resize_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    allocator_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    binary_format_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    text_format_test();
+    std::cout << "\n\n" << "-----------------" << "\n\n";
+    text_output_test();
+}
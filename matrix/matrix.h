@@ -1,8 +1,15 @@
 #ifndef MATRIX_CALCULATOR_MATRIX_H
 #define MATRIX_CALCULATOR_MATRIX_H
 
+#include <memory>
 #include <vector>
+#include <type_traits>
+#include <utility>
+#include "allocator/allocator.h"
+#include "scratch/scratch.h"
 #include "matrix-expression/matrix-expression.h"
+#include "gemm/gemm.h"
+#include "product-chain/product-chain.h"
 
 // structure of slice
 struct Slice {
@@ -14,20 +21,28 @@ struct Slice {
 };
 
 // abstract class of submatrix associated with matrix
-// Cont - type of nested container for inner representation of matrix data
+// submatrix is a view of N x M elements laid out in rows, consecutive rows are "ld" elements apart
+// T - type of elements of matrix (const qualified for read-only views)
 // E - subclass of AbstractSubmatrix
-template<typename Cont, typename E>
-class AbstractSubmatrix : public MatrixExpression<typename Cont::value_type::value_type, AbstractSubmatrix<Cont, E>> {
+template<typename T, typename E>
+class AbstractSubmatrix : public MatrixExpression<std::remove_const_t<T>, AbstractSubmatrix<T, E>> {
 private:
-    Slice n_slice; // horizontal bound of submatrix
-    Slice m_slice; // vertical bound of submatrix
+    std::size_t N; // row count of submatrix
+    std::size_t M; // column count of submatrix
 
 protected:
-    Cont &data; // reference to data of a matrix
+    T *pointer; // pointer to the first element of submatrix
+    std::size_t LD; // leading dimension: distance between starts of consecutive rows
 
 public:
     // type of elements of matrix
-    using value_type = Cont::value_type::value_type;
+    using value_type = std::remove_const_t<T>;
+
+    // elements of submatrix lie in memory
+    static constexpr bool has_storage = true;
+
+    // rows of submatrix are contiguous and can be loaded by packets
+    static constexpr bool has_packets = PacketTraits<value_type>::vectorizable;
 
     // returns copy of element on i-th row and j-th column of submatrix
     value_type operator[](std::size_t i, std::size_t j) const;
@@ -39,31 +54,41 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
-    // return bounds of submatrix
-    std::size_t n_start() const;
-    std::size_t n_end() const;
-    std::size_t m_start() const;
-    std::size_t m_end() const;
+    // return pointer to the first element and leading dimension of submatrix
+    T* data() const;
+    std::size_t ld() const;
+
+    // return description of memory occupied by submatrix
+    StorageView<value_type> view() const;
+    MemoryRegion region() const;
+
+    // returns true if submatrix overlaps "region", except when it occupies exactly the same memory and "aligned" is true
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
 
-    explicit AbstractSubmatrix(Cont &data);
-    AbstractSubmatrix(Cont &data, Slice n_slice);
-    AbstractSubmatrix(Cont &data, Slice n_slice, Slice m_slice);
+    AbstractSubmatrix(T *data, std::size_t N, std::size_t M, std::size_t ld);
 };
 
 // Submatrix with no possibility of changing elements of matrix
 // T - type of elements of matrix
 template<typename T>
-class ConstSubmatrix : public AbstractSubmatrix<const std::vector<std::vector<T>>, ConstSubmatrix<T>> {
+class ConstSubmatrix : public AbstractSubmatrix<const T, ConstSubmatrix<T>> {
     // inheriting all constructors
-    using AbstractSubmatrix<const std::vector<std::vector<T>>, ConstSubmatrix<T>>::AbstractSubmatrix;
+    using AbstractSubmatrix<const T, ConstSubmatrix<T>>::AbstractSubmatrix;
 };
 
+template<typename T1>
+class NoAlias;
+
 // Submatrix with possibility of changing elements of matrix
 // T - type of elements of original matrix
 template<typename T1>
-class Submatrix : public AbstractSubmatrix<std::vector<std::vector<T1>>, Submatrix<T1>> {
+class Submatrix : public AbstractSubmatrix<T1, Submatrix<T1>> {
     // inheriting all constructors
-    using AbstractSubmatrix<std::vector<std::vector<T1>>, Submatrix<T1>>::AbstractSubmatrix;
+    using AbstractSubmatrix<T1, Submatrix<T1>>::AbstractSubmatrix;
 public:
     // returns reference to element of matrix on i-th row and j-th column
     T1& operator[](std::size_t i, std::size_t j);
@@ -82,23 +107,65 @@ public:
     Submatrix operator*=(T1 val);
 
     Submatrix operator/=(T1 val);
+
+    // returns proxy which assigns expressions without checking if they read submatrix
+    NoAlias<T1> noalias();
+};
+
+// proxy of submatrix which assigns expressions directly, without temporary matrix.
+// caller guarantees that expressions don't read memory of submatrix (except the element being written by element-wise ones)
+// T1 - type of elements of matrix
+template<typename T1>
+class NoAlias {
+private:
+    Submatrix<T1> submatrix;
+
+public:
+    template<typename T2, typename E2>
+    Submatrix<T1> operator=(const MatrixExpression<T2, E2> &other);
+
+    template<typename T2, typename E2>
+    Submatrix<T1> operator+=(const MatrixExpression<T2, E2> &other);
+
+    template<typename T2, typename E2>
+    Submatrix<T1> operator-=(const MatrixExpression<T2, E2> &other);
+
+    explicit NoAlias(Submatrix<T1> submatrix);
 };
 
+// returns true if E is product of expressions with elements of type T1, such products are computed by GEMM
+// when their operands lie in memory or were materialized (see Product::prepare)
+template<typename T1, typename E>
+constexpr bool is_gemm_product();
+
+// returns true if E can be evaluated by packets into memory with elements of type T1
+template<typename T1, typename E>
+constexpr bool is_packet_expression();
+
 // class of matrix
+// elements are stored row by row in a single buffer obtained from "Allocator"
 // T - type of elements of matrix
-template<typename T1>
-class Matrix : public MatrixExpression<T1, Matrix<T1>> {
+// Allocator - allocator of elements, e.g. ScratchAllocator or std::pmr::polymorphic_allocator.
+// Buffers of AlignedAllocator are aligned for SIMD, other allocators are fine too, since packets are loaded unaligned
+template<typename T1, typename Allocator = AlignedAllocator<T1>>
+class Matrix : public MatrixExpression<T1, Matrix<T1, Allocator>> {
 private:
     std::size_t N;
     std::size_t M;
 
 protected:
-    std::vector<std::vector<T1>> data;
+    std::vector<T1, Allocator> elements;
 
 public:
     // class Matrix contains data
     static constexpr bool has_data = true;
 
+    // elements of matrix lie in memory
+    static constexpr bool has_storage = true;
+
+    // rows of matrix are contiguous and can be loaded by packets
+    static constexpr bool has_packets = PacketTraits<T1>::vectorizable;
+
     // returns copy of element on i-th row and j-th column
     T1 operator[](std::size_t i, std::size_t j) const;
 
@@ -129,11 +196,32 @@ public:
     std::size_t n() const;
     std::size_t m() const;
 
-    // substitute elements of matrix with elements of "other"
+    // return pointer to the first element and leading dimension of matrix
+    const T1* data() const;
+    T1* data();
+    std::size_t ld() const;
+
+    // return description of memory occupied by matrix
+    StorageView<T1> view() const;
+    MemoryRegion region() const;
+
+    // returns true if matrix overlaps "region", except when it occupies exactly the same memory and "aligned" is true
+    bool aliases(const MemoryRegion &region, bool aligned) const;
+
+    // loads elements of i-th row starting at j-th column into "packet"
+    template<typename P>
+    void load_packet(P &packet, std::size_t i, std::size_t j) const;
+
+    Matrix& operator=(const Matrix &other) = default;
+    // doesn't throw if memory of "other" can always be taken by this matrix's allocator
+    Matrix& operator=(Matrix &&other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+                                               std::allocator_traits<Allocator>::is_always_equal::value);
+
+    // substitute elements of matrix with elements of "other", memory of matrix is reused if sizes match
     template<typename T2, typename E2>
     Matrix& operator=(const MatrixExpression<T2, E2> &other);
 
-    // surface-operations which change matrix
+    // surface-operations which change matrix in place
     template<typename T2, typename E2>
     Matrix& operator+=(const MatrixExpression<T2, E2> &other);
 
@@ -144,19 +232,34 @@ public:
 
     Matrix& operator/=(T1 val);
 
+    // returns proxy which assigns expressions of the same size without checking if they read matrix
+    NoAlias<T1> noalias();
+
+    // changes size of matrix to N x M, memory is reused when it's large enough, so buffers of varying sizes
+    // don't allocate after the largest size. Elements are kept if size doesn't change, otherwise they are unspecified
+    void resize(std::size_t N, std::size_t M);
+
+    // returns copy of allocator of elements
+    Allocator get_allocator() const;
+
     Matrix();
-    explicit Matrix(std::size_t size);
-    Matrix(std::size_t N, std::size_t M);
-    Matrix(const std::vector<std::vector<T1>> &data);
+    explicit Matrix(const Allocator &allocator);
+    Matrix(const Matrix &other) = default;
+    // moved-from matrix is left empty
+    Matrix(Matrix &&other) noexcept;
+    explicit Matrix(std::size_t size, const Allocator &allocator = Allocator());
+    Matrix(std::size_t N, std::size_t M, const Allocator &allocator = Allocator());
+    // imports elements from nested vectors, all rows must have the same size
+    Matrix(const std::vector<std::vector<T1>> &data, const Allocator &allocator = Allocator());
 
     template<typename T2, typename E2>
-    Matrix(const MatrixExpression<T2, E2> &expression);
-
-    // output function
-    template<typename T>
-    friend std::istream& operator>>(std::istream &istream, Matrix<T1> &matrix);
+    Matrix(const MatrixExpression<T2, E2> &expression, const Allocator &allocator = Allocator());
 };
 
+
 #include "matrix.tpp"
 
+// text input is declared after matrix, since it returns matrices
+#include "text-format/text-format.h"
+
 #endif //MATRIX_CALCULATOR_MATRIX_H
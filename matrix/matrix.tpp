@@ -6,85 +6,72 @@ start(start_), end(end_) {}
 
 // AbstractSubmatrix implementation //
 
-template<typename Cont, typename E>
-AbstractSubmatrix<Cont, E>::value_type AbstractSubmatrix<Cont, E>::operator[](std::size_t i, std::size_t j) const {
+template<typename T, typename E>
+AbstractSubmatrix<T, E>::value_type AbstractSubmatrix<T, E>::operator[](std::size_t i, std::size_t j) const {
     if (i >= n() || j >= m()) {
         throw std::out_of_range("attempt to access outside of the bounds");
     }
-    return data[i + n_start()][j + m_start()];
+    return pointer[i * LD + j];
 }
 
-template<typename Cont, typename E>
-AbstractSubmatrix<Cont, E> AbstractSubmatrix<Cont, E>::operator=(const AbstractSubmatrix<Cont, E> &other) {
+template<typename T, typename E>
+AbstractSubmatrix<T, E> AbstractSubmatrix<T, E>::operator=(const AbstractSubmatrix<T, E> &other) {
     return (static_cast<E&>(*this) = other);
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::n() const {
-    return n_slice.end - n_slice.start;
+template<typename T, typename E>
+std::size_t AbstractSubmatrix<T, E>::n() const {
+    return N;
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::m() const {
-    return m_slice.end - m_slice.start;
+template<typename T, typename E>
+std::size_t AbstractSubmatrix<T, E>::m() const {
+    return M;
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::n_start() const {
-    return n_slice.start;
+template<typename T, typename E>
+T* AbstractSubmatrix<T, E>::data() const {
+    return pointer;
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::n_end() const {
-    return n_slice.end;
+template<typename T, typename E>
+std::size_t AbstractSubmatrix<T, E>::ld() const {
+    return LD;
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::m_start() const {
-    return m_slice.start;
+template<typename T, typename E>
+StorageView<typename AbstractSubmatrix<T, E>::value_type> AbstractSubmatrix<T, E>::view() const {
+    return StorageView<value_type>{pointer, LD, 1, false};
 }
 
-template<typename Cont, typename E>
-std::size_t AbstractSubmatrix<Cont, E>::m_end() const {
-    return m_slice.end;
+template<typename T, typename E>
+MemoryRegion AbstractSubmatrix<T, E>::region() const {
+    return MemoryRegion{reinterpret_cast<std::uintptr_t>(pointer), N, M * sizeof(T), LD * sizeof(T)};
 }
 
-template<typename Cont, typename E>
-AbstractSubmatrix<Cont, E>::AbstractSubmatrix(Cont &data_) : AbstractSubmatrix(data_, Slice(0, data_.size())) {}
+template<typename T, typename E>
+bool AbstractSubmatrix<T, E>::aliases(const MemoryRegion &region_, bool aligned) const {
+    return !(aligned && region() == region_) && region().overlaps(region_);
+}
 
-template<typename Cont, typename E>
-AbstractSubmatrix<Cont, E>::AbstractSubmatrix(Cont &data_, Slice n_slice_) :
-data(data_), n_slice(n_slice_) {
-    if (data.size() < n_end()) {
-        throw std::invalid_argument("row slice out of bounds of matri");
-    }
-    else if (data.empty()) {
-        n_slice = Slice();
-        m_slice = Slice();
-    }
-    else {
-        m_slice = Slice(0, data[0].size());
-    }
+template<typename T, typename E>
+template<typename P>
+void AbstractSubmatrix<T, E>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    simd_load(packet, reinterpret_cast<const typename PacketTraits<value_type>::real_type*>(pointer + i * LD + j));
 }
 
-template<typename Cont, typename E>
-AbstractSubmatrix<Cont, E>::AbstractSubmatrix(Cont &data_, Slice n_slice_, Slice m_slice_) :
-data(data_), n_slice(n_slice_), m_slice(m_slice_) {
-    if (data.size() < n_end() || (!data.empty() && data[0].size() < m_end())) {
-        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+template<typename T, typename E>
+AbstractSubmatrix<T, E>::AbstractSubmatrix(T *data_, std::size_t N_, std::size_t M_, std::size_t ld_) :
+N(N_), M(M_), pointer(data_), LD(ld_) {
+    if (N > 1 && LD < M) {
+        throw std::invalid_argument("leading dimension is less than row length of submatrix");
     }
 }
 
 // ConstSubmatrix constructors deduction guide //
 
-template<typename Cont>
-ConstSubmatrix(Cont &data) -> ConstSubmatrix<typename Cont::value_type::value_type>;
-
-template<typename Cont>
-ConstSubmatrix(Cont &data, Slice n_slice) -> ConstSubmatrix<typename Cont::value_type::value_type>;
-
-template<typename Cont>
-ConstSubmatrix(Cont &data, Slice n_slice, Slice m_slice) -> ConstSubmatrix<typename Cont::value_type::value_type>;
+template<typename T>
+ConstSubmatrix(const T *data, std::size_t N, std::size_t M, std::size_t ld) -> ConstSubmatrix<T>;
 
 // Submatrix implementation //
 
@@ -93,7 +80,7 @@ T1& Submatrix<T1>::operator[](std::size_t i, std::size_t j) {
     if (i >= this->n() || j >= this->m()) {
         throw std::out_of_range("attempt to access outside of the bounds");
     }
-    return this->data[i + this->n_start()][j + this->m_start()];
+    return this->pointer[i * this->LD + j];
 }
 
 template<typename T1>
@@ -102,32 +89,32 @@ Submatrix<T1> Submatrix<T1>::operator=(const MatrixExpression<T2, E2> &other) {
     check_n(*this, other);
     check_m(*this, other);
 
-    std::vector<std::vector<T1>> result = std::vector<std::vector<T1>>(this->n(), std::vector<T1>(this->m()));
-    for (int i = 0; i < this->n(); ++i) {
-        for (int j = 0; j < this->m(); ++j) {
-            result[i][j] = other[i,j];
-        }
-    }
+    // expression which reads memory of submatrix is evaluated into temporary matrix first
+    if (static_cast<const E2&>(other).aliases(this->region(), true)) {
+        ScratchBuffer<T1> result = ScratchBuffer<T1>(this->n() * this->m());
+        evaluate(other, result.data(), this->m());
 
-    for (int i = 0; i < this->n(); ++i) {
-        for (int j = 0; j < this->m(); ++j) {
-            (*this)[i,j] = result[i][j];
+        for (std::size_t i = 0; i < this->n(); ++i) {
+            std::copy(result.data() + i * this->m(), result.data() + (i + 1) * this->m(), this->pointer + i * this->LD);
         }
     }
+    else {
+        evaluate(other, this->pointer, this->LD);
+    }
     return *this;
 }
 
 template<typename T1>
 template<typename T2, typename E2>
 Submatrix<T1> Submatrix<T1>::operator+=(const MatrixExpression<T2, E2> &other) {
-    *this = Summation<T1, AbstractSubmatrix<std::vector<std::vector<T1>>, Submatrix<T1>>, E2>(*this, other);
+    *this = Summation<T1, AbstractSubmatrix<T1, Submatrix<T1>>, E2>(*this, other);
     return *this;
 }
 
 template<typename T1>
 template<typename T2, typename E2>
 Submatrix<T1> Submatrix<T1>::operator-=(const MatrixExpression<T2, E2> &other) {
-    *this = Subtraction<T1, AbstractSubmatrix<std::vector<std::vector<T1>>, Submatrix<T1>>, E2>(*this, other);
+    *this = Subtraction<T1, AbstractSubmatrix<T1, Submatrix<T1>>, E2>(*this, other);
     return *this;
 }
 
@@ -143,159 +130,333 @@ Submatrix<T1> Submatrix<T1>::operator/=(T1 val) {
     return *this;
 }
 
-// Submatrix constructions deduction guide //
+template<typename T1>
+NoAlias<T1> Submatrix<T1>::noalias() {
+    return NoAlias<T1>(*this);
+}
 
-template<typename Cont>
-Submatrix(Cont &data) -> Submatrix<typename Cont::value_type::value_type>;
+// Submatrix constructions deduction guide //
 
-template<typename Cont>
-Submatrix(Cont &data, Slice n_slice) -> Submatrix<typename Cont::value_type::value_type>;
+template<typename T>
+Submatrix(T *data, std::size_t N, std::size_t M, std::size_t ld) -> Submatrix<T>;
 
-template<typename Cont>
-Submatrix(Cont &data, Slice n_slice, Slice m_slice) -> Submatrix<typename Cont::value_type::value_type>;
+// NoAlias implementation //
 
-// Matrix implementation //
+template<typename T1>
+template<typename T2, typename E2>
+Submatrix<T1> NoAlias<T1>::operator=(const MatrixExpression<T2, E2> &other) {
+    check_n(submatrix, other);
+    check_m(submatrix, other);
+    evaluate(other, submatrix.data(), submatrix.ld());
+    return submatrix;
+}
 
 template<typename T1>
-T1 Matrix<T1>::operator[](std::size_t i, std::size_t j) const {
-    return data[i][j];
+template<typename T2, typename E2>
+Submatrix<T1> NoAlias<T1>::operator+=(const MatrixExpression<T2, E2> &other) {
+    *this = Summation<T1, AbstractSubmatrix<T1, Submatrix<T1>>, E2>(submatrix, other);
+    return submatrix;
 }
 
 template<typename T1>
-T1& Matrix<T1>::operator[](std::size_t i, std::size_t j) {
-    return data[i][j];
+template<typename T2, typename E2>
+Submatrix<T1> NoAlias<T1>::operator-=(const MatrixExpression<T2, E2> &other) {
+    *this = Subtraction<T1, AbstractSubmatrix<T1, Submatrix<T1>>, E2>(submatrix, other);
+    return submatrix;
 }
 
 template<typename T1>
-ConstSubmatrix<T1> Matrix<T1>::operator[](std::size_t i) const {
+NoAlias<T1>::NoAlias(Submatrix<T1> submatrix_) : submatrix(submatrix_) {}
+
+// evaluation functions implementation //
+
+template<typename T1, typename E>
+constexpr bool is_gemm_product() {
+    if constexpr (is_product<E>::value) {
+        using Lhs = std::remove_cvref_t<decltype(std::declval<const E&>().lhs())>;
+        using Rhs = std::remove_cvref_t<decltype(std::declval<const E&>().rhs())>;
+        return std::is_same_v<typename E::value_type, T1> &&
+               std::is_same_v<typename Lhs::value_type, T1> && std::is_same_v<typename Rhs::value_type, T1>;
+    }
+    else {
+        return false;
+    }
+}
+
+template<typename T1, typename E>
+constexpr bool is_packet_expression() {
+    return E::has_packets && std::is_same_v<typename E::value_type, T1>;
+}
+
+template<typename T1, typename T2, typename E2>
+void evaluate(const MatrixExpression<T2, E2> &expression, T1 *destination, std::size_t ld) {
+    if constexpr (is_product_chain<T1, E2>()) {
+        evaluate_chain(expression, destination, ld);
+        return;
+    }
+
+    // temporaries of prepared expression are released when evaluation ends, also by exception
+    struct Release {
+        const E2 &expression;
+        ~Release() {
+            expression.release();
+        }
+    };
+    static_cast<const E2&>(expression).prepare();
+    Release release = Release{static_cast<const E2&>(expression)};
+
+    if constexpr (is_gemm_product<T1, E2>()) {
+        // operands which neither lie in memory nor were materialized by prepare are read element by element
+        const E2 &product = static_cast<const E2&>(expression);
+        if (product.lhs_in_memory() && product.rhs_in_memory()) {
+            gemm(product.n(), product.m(), product.lhs().m(), product.lhs_view(), product.rhs_view(), destination, ld);
+            return;
+        }
+    }
+
+    // blocks of rows are evaluated in parallel, every element is computed by one thread the same way as in serial code
+    std::size_t work = expression.n() * expression.m() * (static_cast<const E2&>(expression).cost() + 1);
+    parallel_rows(expression.n(), work, [&](std::size_t begin, std::size_t end) {
+        if constexpr (is_packet_expression<T1, E2>()) {
+            packet_assign(static_cast<const E2&>(expression), begin, end, expression.m(), destination, ld);
+        }
+        else {
+            for (std::size_t i = begin; i < end; ++i) {
+                T1 *row = destination + i * ld;
+                for (std::size_t j = 0; j < expression.m(); ++j) {
+                    row[j] = expression[i, j];
+                }
+            }
+        }
+    });
+}
+
+// Matrix implementation //
+
+template<typename T1, typename Allocator>
+T1 Matrix<T1, Allocator>::operator[](std::size_t i, std::size_t j) const {
+    return elements[i * M + j];
+}
+
+template<typename T1, typename Allocator>
+T1& Matrix<T1, Allocator>::operator[](std::size_t i, std::size_t j) {
+    return elements[i * M + j];
+}
+
+template<typename T1, typename Allocator>
+ConstSubmatrix<T1> Matrix<T1, Allocator>::operator[](std::size_t i) const {
     return (*this)[Slice(i, i+1), Slice(0, m())];
 }
 
-template<typename T1>
-Submatrix<T1> Matrix<T1>::operator[](std::size_t i) {
+template<typename T1, typename Allocator>
+Submatrix<T1> Matrix<T1, Allocator>::operator[](std::size_t i) {
     return (*this)[Slice(i, i+1), Slice(0, m())];
 }
 
-template<typename T1>
-ConstSubmatrix<T1> Matrix<T1>::operator[](Slice n_slice) const {
+template<typename T1, typename Allocator>
+ConstSubmatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice) const {
     return (*this)[n_slice, Slice(0, m())];
 }
 
-template<typename T1>
-Submatrix<T1> Matrix<T1>::operator[](Slice n_slice) {
+template<typename T1, typename Allocator>
+Submatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice) {
     return (*this)[n_slice, Slice(0, m())];
 }
 
-template<typename T1>
-ConstSubmatrix<T1> Matrix<T1>::operator[](Slice n_slice, std::size_t m) const {
+template<typename T1, typename Allocator>
+ConstSubmatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice, std::size_t m) const {
     return (*this)[n_slice, Slice(m, m+1)];
 }
 
-template<typename T1>
-Submatrix<T1> Matrix<T1>::operator[](Slice n_slice, std::size_t m) {
+template<typename T1, typename Allocator>
+Submatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice, std::size_t m) {
     return (*this)[n_slice, Slice(m, m+1)];
 }
 
-template<typename T1>
-ConstSubmatrix<T1> Matrix<T1>::operator[](std::size_t n, Slice m_slice) const {
+template<typename T1, typename Allocator>
+ConstSubmatrix<T1> Matrix<T1, Allocator>::operator[](std::size_t n, Slice m_slice) const {
     return (*this)[Slice(n, n+1), m_slice];
 }
 
-template<typename T1>
-Submatrix<T1> Matrix<T1>::operator[](std::size_t n, Slice m_slice) {
+template<typename T1, typename Allocator>
+Submatrix<T1> Matrix<T1, Allocator>::operator[](std::size_t n, Slice m_slice) {
     return (*this)[Slice(n, n+1), m_slice];
 }
 
-template<typename T1>
-ConstSubmatrix<T1> Matrix<T1>::operator[](Slice n_slice, Slice m_slice) const {
-    return ConstSubmatrix<T1>(data, n_slice, m_slice);
+template<typename T1, typename Allocator>
+ConstSubmatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice, Slice m_slice) const {
+    if (n_slice.start > n_slice.end || n_slice.end > n() || m_slice.start > m_slice.end || m_slice.end > m()) {
+        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+    }
+    return ConstSubmatrix<T1>(data() + n_slice.start * ld() + m_slice.start,
+                              n_slice.end - n_slice.start, m_slice.end - m_slice.start, ld());
 }
 
-template<typename T1>
-Submatrix<T1> Matrix<T1>::operator[](Slice n_slice, Slice m_slice) {
-    return Submatrix<T1>(data, n_slice, m_slice);
+template<typename T1, typename Allocator>
+Submatrix<T1> Matrix<T1, Allocator>::operator[](Slice n_slice, Slice m_slice) {
+    if (n_slice.start > n_slice.end || n_slice.end > n() || m_slice.start > m_slice.end || m_slice.end > m()) {
+        throw std::invalid_argument("bounds of submatrix inappropriate for this data");
+    }
+    return Submatrix<T1>(data() + n_slice.start * ld() + m_slice.start,
+                         n_slice.end - n_slice.start, m_slice.end - m_slice.start, ld());
 }
 
-template<typename T1>
-std::size_t Matrix<T1>::n() const {
+template<typename T1, typename Allocator>
+std::size_t Matrix<T1, Allocator>::n() const {
     return N;
 }
 
-template<typename T1>
-std::size_t Matrix<T1>::m() const {
+template<typename T1, typename Allocator>
+std::size_t Matrix<T1, Allocator>::m() const {
     return M;
 }
 
-template<typename T1>
-template<typename T2, typename E2>
-Matrix<T1>& Matrix<T1>::operator=(const MatrixExpression<T2, E2> &other) {
-    *this = Matrix<T1>(other);
+template<typename T1, typename Allocator>
+const T1* Matrix<T1, Allocator>::data() const {
+    return elements.data();
+}
+
+template<typename T1, typename Allocator>
+T1* Matrix<T1, Allocator>::data() {
+    return elements.data();
+}
+
+template<typename T1, typename Allocator>
+std::size_t Matrix<T1, Allocator>::ld() const {
+    return M;
+}
+
+template<typename T1, typename Allocator>
+StorageView<T1> Matrix<T1, Allocator>::view() const {
+    return StorageView<T1>{data(), ld(), 1, false};
+}
+
+template<typename T1, typename Allocator>
+MemoryRegion Matrix<T1, Allocator>::region() const {
+    return MemoryRegion{reinterpret_cast<std::uintptr_t>(data()), N, M * sizeof(T1), ld() * sizeof(T1)};
+}
+
+template<typename T1, typename Allocator>
+bool Matrix<T1, Allocator>::aliases(const MemoryRegion &region_, bool aligned) const {
+    return !(aligned && region() == region_) && region().overlaps(region_);
+}
+
+template<typename T1, typename Allocator>
+template<typename P>
+void Matrix<T1, Allocator>::load_packet(P &packet, std::size_t i, std::size_t j) const {
+    simd_load(packet, reinterpret_cast<const typename PacketTraits<T1>::real_type*>(data() + i * ld() + j));
+}
+
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator=(Matrix<T1, Allocator> &&other)
+noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+         std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this != &other) {
+        N = std::exchange(other.N, 0);
+        M = std::exchange(other.M, 0);
+        elements = std::move(other.elements);
+        other.elements.clear();
+    }
     return *this;
 }
 
-template<typename T1>
+template<typename T1, typename Allocator>
 template<typename T2, typename E2>
-Matrix<T1>& Matrix<T1>::operator+=(const MatrixExpression<T2, E2> &other) {
-    *this = Summation<T1, Matrix<T1>, E2>(*this, other);
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator=(const MatrixExpression<T2, E2> &other) {
+    if (n() == other.n() && m() == other.m()) {
+        (*this)[Slice(0, n()), Slice(0, m())] = other;
+    }
+    else if (static_cast<const E2&>(other).aliases(region(), false)) {
+        *this = Matrix<T1, Allocator>(other, get_allocator());
+    }
+    else {
+        // memory of matrix isn't read by expression, so it's resized in place without temporary matrix
+        resize(other.n(), other.m());
+        noalias() = other;
+    }
     return *this;
 }
 
-template<typename T1>
+template<typename T1, typename Allocator>
 template<typename T2, typename E2>
-Matrix<T1>& Matrix<T1>::operator-=(const MatrixExpression<T2, E2> &other) {
-    *this = Subtraction<T1, Matrix<T1>, E2>(*this, other);
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator+=(const MatrixExpression<T2, E2> &other) {
+    (*this)[Slice(0, n()), Slice(0, m())] += other;
     return *this;
 }
 
-template<typename T1>
-Matrix<T1>& Matrix<T1>::operator*=(T1 val) {
-    *this = *this * val;
+template<typename T1, typename Allocator>
+template<typename T2, typename E2>
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator-=(const MatrixExpression<T2, E2> &other) {
+    (*this)[Slice(0, n()), Slice(0, m())] -= other;
     return *this;
 }
 
-template<typename T1>
-Matrix<T1>& Matrix<T1>::operator/=(T1 val) {
-    *this = *this / val;
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator*=(T1 val) {
+    (*this)[Slice(0, n()), Slice(0, m())] *= val;
     return *this;
 }
 
-template<typename T1>
-Matrix<T1>::Matrix() : Matrix(0, 0) {}
-
-template<typename T1>
-Matrix<T1>::Matrix(std::size_t size) : Matrix(size, size) {}
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>& Matrix<T1, Allocator>::operator/=(T1 val) {
+    (*this)[Slice(0, n()), Slice(0, m())] /= val;
+    return *this;
+}
 
-template<typename T1>
-Matrix<T1>::Matrix(std::size_t N_, std::size_t M_)
-: N(N_), M(M_), data(std::vector<std::vector<T1>>(n(), std::vector<T1>(m()))) {}
+template<typename T1, typename Allocator>
+NoAlias<T1> Matrix<T1, Allocator>::noalias() {
+    return NoAlias<T1>((*this)[Slice(0, n()), Slice(0, m())]);
+}
 
-template<typename T1>
-Matrix<T1>::Matrix(const std::vector<std::vector<T1>> &data_) : N(data.size()), data(data_) {
-    M = (data.empty() ? 0 : data[0].size());
+template<typename T1, typename Allocator>
+void Matrix<T1, Allocator>::resize(std::size_t N_, std::size_t M_) {
+    N = N_;
+    M = M_;
+    elements.resize(N_ * M_);
 }
 
-template<typename T1>
-template<typename T2, typename E2>
-Matrix<T1>::Matrix(const MatrixExpression<T2, E2> &expression) : Matrix(expression.n(), expression.m()) {
-    (*this)[Slice(0, n()), Slice(0, m())] = expression;
+template<typename T1, typename Allocator>
+Allocator Matrix<T1, Allocator>::get_allocator() const {
+    return elements.get_allocator();
 }
 
-template<typename Cont, typename E>
-Matrix(AbstractSubmatrix<Cont, E>) -> Matrix<typename AbstractSubmatrix<Cont, E>::value_type>;
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix() : Matrix(0, 0) {}
 
-// input function //
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix(const Allocator &allocator) : Matrix(0, 0, allocator) {}
 
-template<typename T>
-std::istream& operator>>(std::istream &istream, Matrix<T> &matrix) {
-    std::size_t n, m;
-    istream >> n >> m;
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix(Matrix<T1, Allocator> &&other) noexcept :
+N(std::exchange(other.N, 0)), M(std::exchange(other.M, 0)), elements(std::move(other.elements)) {
+    other.elements.clear();
+}
+
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix(std::size_t size, const Allocator &allocator) : Matrix(size, size, allocator) {}
 
-    matrix = Matrix<T>(n, m);
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix(std::size_t N_, std::size_t M_, const Allocator &allocator)
+: N(N_), M(M_), elements(N_ * M_, allocator) {}
 
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < m; ++j) {
-            istream >> matrix[i, j];
+template<typename T1, typename Allocator>
+Matrix<T1, Allocator>::Matrix(const std::vector<std::vector<T1>> &data_, const Allocator &allocator)
+: Matrix(data_.size(), data_.empty() ? 0 : data_[0].size(), allocator) {
+    for (std::size_t i = 0; i < n(); ++i) {
+        if (data_[i].size() != m()) {
+            throw std::invalid_argument("rows of matrix have different sizes");
         }
+        std::copy(data_[i].begin(), data_[i].end(), elements.begin() + i * ld());
     }
-    return istream;
-}
\ No newline at end of file
+}
+
+template<typename T1, typename Allocator>
+template<typename T2, typename E2>
+Matrix<T1, Allocator>::Matrix(const MatrixExpression<T2, E2> &expression, const Allocator &allocator)
+: Matrix(expression.n(), expression.m(), allocator) {
+    // new memory can't be read by expression
+    noalias() = expression;
+}
+
+template<typename T, typename E>
+Matrix(AbstractSubmatrix<T, E>) -> Matrix<typename AbstractSubmatrix<T, E>::value_type>;
@@ -0,0 +1,34 @@
+#ifndef MATRIX_CALCULATOR_PRODUCT_CHAIN_H
+#define MATRIX_CALCULATOR_PRODUCT_CHAIN_H
+
+#include <array>
+#include "../matrix-expression/matrix-expression.h"
+#include "../gemm/gemm.h"
+
+// factor of product chain lying in memory
+// T - type of elements
+template<typename T>
+struct ChainFactor {
+    StorageView<T> view;
+    std::size_t n;
+    std::size_t m;
+};
+
+// collects factors of "expression" to "factors" starting at "index", scalars are multiplied into "scale".
+// factors which don't lie in memory are evaluated into "buffers"
+template<typename T, typename E>
+void collect_factors(const E &expression, ChainFactor<T> *factors, ScratchBuffer<T> *buffers, std::size_t &index, T &scale);
+
+// fills "split" with the cheapest parenthesization of chain of "Count" factors:
+// product of factors first..last is split after factor split[first * Count + last]. Returns count of multiplications
+template<typename T, std::size_t Count>
+std::size_t chain_order(const std::array<ChainFactor<T>, Count> &factors, std::array<std::size_t, Count * Count> &split);
+
+// computes product of factors first..last in order given by "split" (see chain_order)
+template<typename T>
+void multiply_chain(const ChainFactor<T> *factors, const std::size_t *split, std::size_t count,
+                    std::size_t first, std::size_t last, T *destination, std::size_t ld);
+
+#include "product-chain.tpp"
+
+#endif //MATRIX_CALCULATOR_PRODUCT_CHAIN_H
@@ -0,0 +1,125 @@
+#include <limits>
+
+// helper functions of product chain //
+
+// multiply "scale" by scalar of negation, product or division by scalar
+template<typename T1, typename T, typename E>
+void multiply_scale(T1 &scale, const Negation<T, E>&) {
+    scale = -scale;
+}
+
+template<typename T1, typename T, typename E, typename V>
+void multiply_scale(T1 &scale, const ScalarProduct<T, E, V> &expression) {
+    scale *= expression.scalar();
+}
+
+template<typename T1, typename T, typename E, typename V>
+void multiply_scale(T1 &scale, const ScalarDivision<T, E, V> &expression) {
+    scale /= expression.scalar();
+}
+
+// product chain functions implementation //
+
+template<typename T, typename E>
+void collect_factors(const E &expression, ChainFactor<T> *factors, ScratchBuffer<T> *buffers, std::size_t &index, T &scale) {
+    if constexpr (is_product<E>::value) {
+        collect_factors(expression.lhs(), factors, buffers, index, scale);
+        collect_factors(expression.rhs(), factors, buffers, index, scale);
+    }
+    else if constexpr (is_scaling<E>::value) {
+        multiply_scale(scale, expression);
+        collect_factors(expression.operand(), factors, buffers, index, scale);
+    }
+    else {
+        if constexpr (E::has_storage) {
+            factors[index] = ChainFactor<T>{expression.view(), expression.n(), expression.m()};
+        }
+        else {
+            buffers[index].resize(expression.n() * expression.m());
+            evaluate(expression, buffers[index].data(), expression.m());
+            factors[index] = ChainFactor<T>{StorageView<T>{buffers[index].data(), expression.m(), 1, false},
+                                            expression.n(), expression.m()};
+        }
+        ++index;
+    }
+}
+
+template<typename T, std::size_t Count>
+std::size_t chain_order(const std::array<ChainFactor<T>, Count> &factors, std::array<std::size_t, Count * Count> &split) {
+    // classic matrix-chain order: cost[first * count + last] - count of multiplications of the cheapest
+    // parenthesization of factors first..last, product of n x k and k x m matrices costs n * k * m.
+    // Vector factors make every product they take part in a matrix-vector one
+    constexpr std::size_t count = Count;
+    std::array<std::size_t, count * count> cost;
+    for (std::size_t first = 0; first < count; ++first) {
+        cost[first * count + first] = 0;
+    }
+    for (std::size_t length = 2; length <= count; ++length) {
+        for (std::size_t first = 0; first + length <= count; ++first) {
+            std::size_t last = first + length - 1;
+            cost[first * count + last] = std::numeric_limits<std::size_t>::max();
+            for (std::size_t s = first; s < last; ++s) {
+                std::size_t c = cost[first * count + s] + cost[(s + 1) * count + last] +
+                                factors[first].n * factors[s].m * factors[last].m;
+                if (c < cost[first * count + last]) {
+                    cost[first * count + last] = c;
+                    split[first * count + last] = s;
+                }
+            }
+        }
+    }
+    return cost[count - 1];
+}
+
+template<typename T>
+void multiply_chain(const ChainFactor<T> *factors, const std::size_t *split, std::size_t count,
+                    std::size_t first, std::size_t last, T *destination, std::size_t ld) {
+    std::size_t s = split[first * count + last];
+    std::size_t n = factors[first].n;
+    std::size_t k = factors[s].m;
+    std::size_t m = factors[last].m;
+
+    // subchains of several factors are computed into temporaries
+    ScratchBuffer<T> left_value;
+    StorageView<T> left = factors[first].view;
+    if (first != s) {
+        left_value.resize(n * k);
+        multiply_chain(factors, split, count, first, s, left_value.data(), k);
+        left = StorageView<T>{left_value.data(), k, 1, false};
+    }
+
+    ScratchBuffer<T> right_value;
+    StorageView<T> right = factors[last].view;
+    if (s + 1 != last) {
+        right_value.resize(k * m);
+        multiply_chain(factors, split, count, s + 1, last, right_value.data(), m);
+        right = StorageView<T>{right_value.data(), m, 1, false};
+    }
+
+    gemm(n, m, k, left, right, destination, ld);
+}
+
+template<typename T1, typename T2, typename E2>
+void evaluate_chain(const MatrixExpression<T2, E2> &expression, T1 *destination, std::size_t ld) {
+    constexpr std::size_t count = ProductChain<T1, E2>::length;
+    std::array<ChainFactor<T1>, count> factors;
+    std::array<ScratchBuffer<T1>, count> buffers;
+    std::array<std::size_t, count * count> split;
+
+    std::size_t index = 0;
+    T1 scale = T1(1);
+    collect_factors(static_cast<const E2&>(expression), factors.data(), buffers.data(), index, scale);
+
+    chain_order(factors, split);
+    multiply_chain(factors.data(), split.data(), count, 0, count - 1, destination, ld);
+
+    // all scalars are applied once to the result
+    if (scale != T1(1)) {
+        for (std::size_t i = 0; i < expression.n(); ++i) {
+            T1 *row = destination + i * ld;
+            for (std::size_t j = 0; j < expression.m(); ++j) {
+                row[j] *= scale;
+            }
+        }
+    }
+}
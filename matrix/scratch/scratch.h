@@ -0,0 +1,172 @@
+#ifndef MATRIX_CALCULATOR_SCRATCH_H
+#define MATRIX_CALCULATOR_SCRATCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "../allocator/allocator.h"
+
+// pool of memory blocks for temporaries of expression evaluation, each thread has its own pool.
+// released blocks are kept for reuse, so repeated evaluation of the same expression doesn't allocate.
+// Blocks larger than "max_block_bytes" aren't pooled, so pool holds at most capacity * max_block_bytes bytes
+class ScratchPool {
+private:
+    struct Block {
+        void *pointer;
+        std::size_t bytes;
+    };
+
+    std::vector<Block> blocks;
+
+public:
+    // count of released blocks kept by pool, the rest are freed
+    static constexpr std::size_t capacity = 16;
+
+    // size of the largest pooled block, larger blocks are taken from heap and freed at once
+    static constexpr std::size_t max_block_bytes = std::size_t(4) << 20;
+
+    // returns block of at least "bytes" bytes aligned to MATRIX_ALIGNMENT, "bytes" is updated with real size of block
+    void* acquire(std::size_t &bytes);
+
+    // returns block obtained from acquire to pool
+    void release(void *pointer, std::size_t bytes);
+
+    // frees all released blocks kept by pool
+    void trim();
+
+    // returns pool of calling thread
+    static ScratchPool& local();
+
+    ScratchPool() = default;
+    ScratchPool(const ScratchPool &other) = delete;
+    ScratchPool& operator=(const ScratchPool &other) = delete;
+    ~ScratchPool();
+};
+
+// scoped arena for temporaries of calling thread, arenas of one thread form a stack.
+// while arena is active, scratch buffers and ScratchAllocator created on its thread take memory from it by bumping a pointer,
+// memory released in reverse order of allocation is reused at once, the rest is freed together with arena.
+// Other threads keep using their own pools, so arena needs no locking
+class ScratchArena {
+private:
+    struct Chunk {
+        Chunk *previous;
+        std::size_t bytes;
+    };
+
+    Chunk *chunk; // the most recent chunk, nullptr until the first allocation
+    char *top; // the first free byte of chunk
+    char *end; // end of chunk
+    std::size_t next_bytes; // size of the next chunk
+    std::size_t used_bytes;
+    ScratchArena *parent; // arena which was active before this one
+    std::size_t serial; // unique number of arena, tells apart arenas created at the same address
+
+    // adds chunk which fits at least "bytes" bytes
+    void grow(std::size_t bytes);
+
+    // returns reference to the innermost active arena of calling thread
+    static ScratchArena*& innermost();
+
+public:
+    // size of the first chunk if it isn't specified
+    static constexpr std::size_t default_bytes = std::size_t(1) << 20;
+
+    // returns block of "bytes" bytes aligned to MATRIX_ALIGNMENT
+    void* allocate(std::size_t bytes);
+
+    // releases block obtained from allocate, memory is reused only if block is the last one allocated
+    void deallocate(void *pointer, std::size_t bytes);
+
+    // returns count of bytes taken from arena, including padding
+    std::size_t used() const;
+
+    // returns unique number of arena
+    std::size_t id() const;
+
+    // returns the innermost active arena of calling thread, nullptr if there is none
+    static ScratchArena* active();
+
+    // returns active arena of calling thread with number "id", nullptr if it was destroyed
+    static ScratchArena* find(std::size_t id);
+
+    // makes arena active on calling thread, "bytes" - size of the first chunk
+    explicit ScratchArena(std::size_t bytes = default_bytes);
+    ScratchArena(const ScratchArena &other) = delete;
+    ScratchArena& operator=(const ScratchArena &other) = delete;
+    // frees all chunks and restores previous arena, must be destroyed on the thread which created it
+    ~ScratchArena();
+};
+
+// allocator taking memory from arena which was active on construction, or from heap if there was none.
+// containers using it must not outlive the arena and must allocate only on its thread
+// T - type of allocated elements
+template<typename T>
+class ScratchAllocator {
+private:
+    template<typename U>
+    friend class ScratchAllocator;
+
+    ScratchArena *arena;
+
+public:
+    using value_type = T;
+
+    // allocates uninitialized storage for "count" elements aligned to MATRIX_ALIGNMENT
+    T* allocate(std::size_t count);
+
+    // releases storage obtained from allocate
+    void deallocate(T *pointer, std::size_t count);
+
+    // returns arena of allocator, nullptr if memory is taken from heap
+    ScratchArena* resource() const;
+
+    ScratchAllocator();
+
+    template<typename U>
+    ScratchAllocator(const ScratchAllocator<U> &other);
+};
+
+template<typename T1, typename T2>
+bool operator==(const ScratchAllocator<T1> &first, const ScratchAllocator<T2> &second);
+
+// buffer of elements taken from scratch pool of calling thread, returned to pool on destruction.
+// Elements of trivially copyable types (numbers and their complex counterparts) are left uninitialized,
+// elements of other types are value-initialized and destroyed with buffer.
+// copy of buffer is empty, so expressions holding buffers stay copyable.
+// Buffer takes memory from active scratch arena instead, if there is one, then its data must not be read after
+// the arena is destroyed. Expressions release their buffers when evaluation ends, so they don't outlive arenas
+// T - type of elements
+template<typename T>
+class ScratchBuffer {
+private:
+    T *pointer;
+    std::size_t bytes;
+    std::size_t arena; // number of arena which memory was taken from, 0 if it came from pool
+
+    // returns memory to pool or arena without destroying elements
+    void deallocate();
+
+public:
+    // returns pointer to the first element, nullptr if buffer is empty
+    T* data() const;
+
+    // makes buffer hold at least "size" elements, previous contents are lost
+    void resize(std::size_t size);
+
+    // destroys elements and returns memory to pool
+    void clear();
+
+    ScratchBuffer();
+    explicit ScratchBuffer(std::size_t size);
+    ScratchBuffer(const ScratchBuffer &other);
+    ScratchBuffer& operator=(const ScratchBuffer &other);
+    ~ScratchBuffer();
+};
+
+#include "scratch.tpp"
+
+#endif //MATRIX_CALCULATOR_SCRATCH_H
@@ -0,0 +1,266 @@
+// ScratchPool implementation //
+
+inline void* ScratchPool::acquire(std::size_t &bytes) {
+    // takes the smallest released block which is big enough
+    std::size_t best = blocks.size();
+    for (std::size_t k = 0; k < blocks.size(); ++k) {
+        if (blocks[k].bytes >= bytes && (best == blocks.size() || blocks[k].bytes < blocks[best].bytes)) {
+            best = k;
+        }
+    }
+    if (best != blocks.size()) {
+        Block block = blocks[best];
+        blocks[best] = blocks.back();
+        blocks.pop_back();
+        bytes = block.bytes;
+        return block.pointer;
+    }
+
+    // sizes of pooled blocks are rounded up to a power of two, so blocks fit more requests when reused.
+    // Large blocks aren't rounded, they aren't reused and their allocation is paid off by the work on them
+    std::size_t size = MATRIX_ALIGNMENT;
+    if (bytes > max_block_bytes) {
+        size = (bytes + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    }
+    while (size < bytes) {
+        size *= 2;
+    }
+    bytes = size;
+    return ::operator new(size, std::align_val_t(MATRIX_ALIGNMENT));
+}
+
+inline void ScratchPool::release(void *pointer, std::size_t bytes) {
+    if (bytes > max_block_bytes) {
+        ::operator delete(pointer, std::align_val_t(MATRIX_ALIGNMENT));
+        return;
+    }
+    if (blocks.size() < capacity) {
+        blocks.push_back(Block{pointer, bytes});
+        return;
+    }
+
+    // pool is full, frees the smallest of blocks
+    std::size_t smallest = 0;
+    for (std::size_t k = 1; k < blocks.size(); ++k) {
+        if (blocks[k].bytes < blocks[smallest].bytes) {
+            smallest = k;
+        }
+    }
+    if (blocks[smallest].bytes < bytes) {
+        std::swap(blocks[smallest].pointer, pointer);
+        std::swap(blocks[smallest].bytes, bytes);
+    }
+    ::operator delete(pointer, std::align_val_t(MATRIX_ALIGNMENT));
+}
+
+inline void ScratchPool::trim() {
+    for (Block &block : blocks) {
+        ::operator delete(block.pointer, std::align_val_t(MATRIX_ALIGNMENT));
+    }
+    blocks.clear();
+}
+
+inline ScratchPool& ScratchPool::local() {
+    thread_local ScratchPool pool;
+    return pool;
+}
+
+inline ScratchPool::~ScratchPool() {
+    trim();
+}
+
+// ScratchArena implementation //
+
+inline void ScratchArena::grow(std::size_t bytes) {
+    // the first MATRIX_ALIGNMENT bytes of chunk hold header, so memory after it stays aligned
+    std::size_t size = std::max(next_bytes, bytes + MATRIX_ALIGNMENT);
+    Chunk *added = static_cast<Chunk*>(::operator new(size, std::align_val_t(MATRIX_ALIGNMENT)));
+    added->previous = chunk;
+    added->bytes = size;
+    chunk = added;
+    top = reinterpret_cast<char*>(added) + MATRIX_ALIGNMENT;
+    end = reinterpret_cast<char*>(added) + size;
+    // chunks grow geometrically, so arena holds few of them and is freed quickly
+    next_bytes = 2 * size;
+}
+
+inline ScratchArena*& ScratchArena::innermost() {
+    thread_local ScratchArena *arena = nullptr;
+    return arena;
+}
+
+inline void* ScratchArena::allocate(std::size_t bytes) {
+    // sizes are rounded up to alignment, so every block starts aligned
+    bytes = (std::max<std::size_t>(bytes, 1) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    if (chunk == nullptr || static_cast<std::size_t>(end - top) < bytes) {
+        grow(bytes);
+    }
+    void *pointer = top;
+    top += bytes;
+    used_bytes += bytes;
+    return pointer;
+}
+
+inline void ScratchArena::deallocate(void *pointer, std::size_t bytes) {
+    bytes = (std::max<std::size_t>(bytes, 1) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    if (static_cast<char*>(pointer) + bytes == top) {
+        top = static_cast<char*>(pointer);
+        used_bytes -= bytes;
+    }
+}
+
+inline std::size_t ScratchArena::used() const {
+    return used_bytes;
+}
+
+inline std::size_t ScratchArena::id() const {
+    return serial;
+}
+
+inline ScratchArena* ScratchArena::active() {
+    return innermost();
+}
+
+inline ScratchArena* ScratchArena::find(std::size_t id) {
+    for (ScratchArena *arena = innermost(); arena != nullptr; arena = arena->parent) {
+        if (arena->serial == id) {
+            return arena;
+        }
+    }
+    return nullptr;
+}
+
+inline ScratchArena::ScratchArena(std::size_t bytes) :
+chunk(nullptr), top(nullptr), end(nullptr), next_bytes(bytes), used_bytes(0), parent(innermost()) {
+    static std::atomic<std::size_t> count = 0;
+    serial = count.fetch_add(1, std::memory_order_relaxed) + 1;
+    innermost() = this;
+}
+
+inline ScratchArena::~ScratchArena() {
+    innermost() = parent;
+    while (chunk != nullptr) {
+        Chunk *previous = chunk->previous;
+        ::operator delete(chunk, std::align_val_t(MATRIX_ALIGNMENT));
+        chunk = previous;
+    }
+}
+
+// ScratchAllocator implementation //
+
+template<typename T>
+T* ScratchAllocator<T>::allocate(std::size_t count) {
+    if (arena != nullptr) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(MATRIX_ALIGNMENT)));
+}
+
+template<typename T>
+void ScratchAllocator<T>::deallocate(T *pointer, std::size_t count) {
+    if (arena != nullptr) {
+        arena->deallocate(pointer, count * sizeof(T));
+    }
+    else {
+        ::operator delete(pointer, std::align_val_t(MATRIX_ALIGNMENT));
+    }
+}
+
+template<typename T>
+ScratchArena* ScratchAllocator<T>::resource() const {
+    return arena;
+}
+
+template<typename T>
+ScratchAllocator<T>::ScratchAllocator() : arena(ScratchArena::active()) {}
+
+template<typename T>
+template<typename U>
+ScratchAllocator<T>::ScratchAllocator(const ScratchAllocator<U> &other) : arena(other.arena) {}
+
+template<typename T1, typename T2>
+bool operator==(const ScratchAllocator<T1> &first, const ScratchAllocator<T2> &second) {
+    return first.resource() == second.resource();
+}
+
+// ScratchBuffer implementation //
+
+template<typename T>
+T* ScratchBuffer<T>::data() const {
+    return pointer;
+}
+
+template<typename T>
+void ScratchBuffer<T>::deallocate() {
+    if (arena == 0) {
+        ScratchPool::local().release(pointer, bytes);
+    }
+    // memory of destroyed arena (or arena of other thread) is already owned by it
+    else if (ScratchArena *owner = ScratchArena::find(arena)) {
+        owner->deallocate(pointer, bytes);
+    }
+    pointer = nullptr;
+    bytes = 0;
+    arena = 0;
+}
+
+template<typename T>
+void ScratchBuffer<T>::resize(std::size_t size) {
+    // memory of destroyed arena is never reused, buffer takes new memory instead
+    if (size * sizeof(T) <= bytes && (arena == 0 || ScratchArena::find(arena) != nullptr)) {
+        return;
+    }
+    clear();
+    bytes = size * sizeof(T);
+    if (ScratchArena *active = ScratchArena::active()) {
+        pointer = static_cast<T*>(active->allocate(bytes));
+        arena = active->id();
+    }
+    else {
+        pointer = static_cast<T*>(ScratchPool::local().acquire(bytes));
+    }
+
+    if constexpr (!std::is_trivially_copyable_v<T>) {
+        try {
+            std::uninitialized_value_construct_n(pointer, bytes / sizeof(T));
+        }
+        catch (...) {
+            deallocate();
+            throw;
+        }
+    }
+}
+
+template<typename T>
+void ScratchBuffer<T>::clear() {
+    if (pointer != nullptr) {
+        // elements in memory of destroyed arena are gone together with it
+        if constexpr (!std::is_trivially_copyable_v<T>) {
+            if (arena == 0 || ScratchArena::find(arena) != nullptr) {
+                std::destroy_n(pointer, bytes / sizeof(T));
+            }
+        }
+        deallocate();
+    }
+}
+
+template<typename T>
+ScratchBuffer<T>::ScratchBuffer() : pointer(nullptr), bytes(0), arena(0) {}
+
+template<typename T>
+ScratchBuffer<T>::ScratchBuffer(std::size_t size) : ScratchBuffer() {
+    resize(size);
+}
+
+template<typename T>
+ScratchBuffer<T>::ScratchBuffer(const ScratchBuffer&) : ScratchBuffer() {}
+
+template<typename T>
+ScratchBuffer<T>& ScratchBuffer<T>::operator=(const ScratchBuffer&) {
+    return *this;
+}
+
+template<typename T>
+ScratchBuffer<T>::~ScratchBuffer() {
+    clear();
+}
@@ -0,0 +1,82 @@
+#ifndef MATRIX_CALCULATOR_SIMD_H
+#define MATRIX_CALCULATOR_SIMD_H
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+// instruction sets for which vectorized kernels are compiled
+enum class SimdLevel {
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+// returns the widest instruction set supported by processor, detected once per process
+SimdLevel detected_simd_level();
+
+// returns instruction set used by vectorized kernels, equals detected_simd_level() unless lowered by set_simd_level
+SimdLevel simd_level();
+
+// limits instruction set used by vectorized kernels, SimdLevel::scalar disables vectorization
+// levels above detected_simd_level() are lowered to it
+void set_simd_level(SimdLevel level);
+
+// vector of W elements of type T, operations on it are compiled to instructions of the enclosing function's target
+// T - type of elements, W - count of elements
+template<typename T, std::size_t W>
+struct SimdVector {
+    typedef T type __attribute__((vector_size(W * sizeof(T))));
+};
+
+// describes how elements of type T are stored in packets
+// complex numbers are stored as interleaved real and imaginary parts
+template<typename T>
+struct PacketTraits {
+    static constexpr bool vectorizable = false;
+};
+
+template<>
+struct PacketTraits<float> {
+    static constexpr bool vectorizable = true;
+    static constexpr bool complex = false;
+    using real_type = float;
+};
+
+template<>
+struct PacketTraits<double> {
+    static constexpr bool vectorizable = true;
+    static constexpr bool complex = false;
+    using real_type = double;
+};
+
+template<typename T>
+struct PacketTraits<std::complex<T>> {
+    static constexpr bool vectorizable = PacketTraits<T>::vectorizable;
+    static constexpr bool complex = true;
+    using real_type = T;
+};
+
+// loads and stores vector from unaligned memory
+template<typename V, typename T>
+void simd_load(V &vector, const T *pointer);
+
+template<typename V, typename T>
+void simd_store(T *pointer, const V &vector);
+
+// multiplies interleaved complex numbers in "packet" by "val"
+template<typename P, typename T>
+void complex_scale(P &packet, std::complex<T> val);
+
+// writes rows "begin".."end"-1 of m columns of "expression" to memory starting at "destination" with leading dimension
+// "ld" (row i goes to destination + i * ld) using packets of the widest enabled instruction set, expression must provide
+// "template<typename P> void load_packet(P &packet, std::size_t i, std::size_t j) const"
+// which loads elements of i-th row starting at j-th column
+template<typename T, typename E>
+void packet_assign(const E &expression, std::size_t begin, std::size_t end, std::size_t m, T *destination, std::size_t ld);
+
+#include "simd.tpp"
+
+#endif //MATRIX_CALCULATOR_SIMD_H
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+// SimdLevel detection implementation //
+
+inline SimdLevel detected_simd_level() {
+    static const SimdLevel level = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) { return SimdLevel::avx512; }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) { return SimdLevel::avx2; }
+        if (__builtin_cpu_supports("sse2")) { return SimdLevel::sse2; }
+#endif
+        return SimdLevel::scalar;
+    }();
+    return level;
+}
+
+// enabled instruction set shared by all threads
+inline std::atomic<SimdLevel>& enabled_simd_level() {
+    static std::atomic<SimdLevel> level = detected_simd_level();
+    return level;
+}
+
+inline SimdLevel simd_level() {
+    return enabled_simd_level().load(std::memory_order_relaxed);
+}
+
+inline void set_simd_level(SimdLevel level) {
+    enabled_simd_level().store(std::min(level, detected_simd_level()), std::memory_order_relaxed);
+}
+
+// load and store implementation //
+
+template<typename V, typename T>
+[[gnu::always_inline]] inline void simd_load(V &vector, const T *pointer) {
+    std::memcpy(&vector, pointer, sizeof(V));
+}
+
+template<typename V, typename T>
+[[gnu::always_inline]] inline void simd_store(T *pointer, const V &vector) {
+    std::memcpy(pointer, &vector, sizeof(V));
+}
+
+// packet arithmetic implementation //
+
+template<typename P, typename T>
+[[gnu::always_inline]] inline void complex_scale(P &packet, std::complex<T> val) {
+    constexpr std::size_t lanes = sizeof(P) / sizeof(T);
+    using Mask = typename SimdVector<std::conditional_t<sizeof(T) == 8, std::int64_t, std::int32_t>, lanes>::type;
+
+    // swaps real and imaginary parts of every number
+    Mask mask;
+    P sign;
+    for (std::size_t k = 0; k < lanes; ++k) {
+        mask[k] = k ^ 1;
+        sign[k] = (k % 2 == 0 ? -val.imag() : val.imag());
+    }
+    P swapped = __builtin_shuffle(packet, mask);
+    packet = packet * val.real() + swapped * sign;
+}
+
+// packet assignment implementation //
+
+// assigns rows "begin".."end"-1 of expression with packets of "bytes" bytes, the rest of every row is assigned element by element
+template<typename T, typename E, std::size_t bytes>
+[[gnu::always_inline]] inline void packet_assign_rows(const E &expression, std::size_t begin, std::size_t end, std::size_t m,
+                                                      T *destination, std::size_t ld) {
+    using Real = typename PacketTraits<T>::real_type;
+    using Packet = typename SimdVector<Real, bytes / sizeof(Real)>::type;
+    constexpr std::size_t step = bytes / sizeof(T);
+
+    for (std::size_t i = begin; i < end; ++i) {
+        T *row = destination + i * ld;
+        std::size_t j = 0;
+        for (; j + step <= m; j += step) {
+            Packet packet;
+            expression.load_packet(packet, i, j);
+            simd_store(reinterpret_cast<Real*>(row + j), packet);
+        }
+        for (; j < m; ++j) {
+            row[j] = expression[i, j];
+        }
+    }
+}
+
+// flatten inlines the whole expression tree into the kernel compiled for the instruction set
+template<typename T, typename E>
+[[gnu::flatten]]
+void packet_assign_sse2(const E &expression, std::size_t begin, std::size_t end, std::size_t m, T *destination, std::size_t ld) {
+    packet_assign_rows<T, E, 16>(expression, begin, end, m, destination, ld);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template<typename T, typename E>
+[[gnu::target("avx2,fma"), gnu::flatten]]
+void packet_assign_avx2(const E &expression, std::size_t begin, std::size_t end, std::size_t m, T *destination, std::size_t ld) {
+    packet_assign_rows<T, E, 32>(expression, begin, end, m, destination, ld);
+}
+
+template<typename T, typename E>
+[[gnu::target("avx512f"), gnu::flatten]]
+void packet_assign_avx512(const E &expression, std::size_t begin, std::size_t end, std::size_t m, T *destination, std::size_t ld) {
+    packet_assign_rows<T, E, 64>(expression, begin, end, m, destination, ld);
+}
+#endif
+
+template<typename T, typename E>
+void packet_assign(const E &expression, std::size_t begin, std::size_t end, std::size_t m, T *destination, std::size_t ld) {
+    switch (simd_level()) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::avx512:
+            packet_assign_avx512(expression, begin, end, m, destination, ld);
+            return;
+        case SimdLevel::avx2:
+            packet_assign_avx2(expression, begin, end, m, destination, ld);
+            return;
+#endif
+        case SimdLevel::sse2:
+            packet_assign_sse2(expression, begin, end, m, destination, ld);
+            return;
+        default:
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t j = 0; j < m; ++j) {
+                    destination[i * ld + j] = expression[i, j];
+                }
+            }
+    }
+}
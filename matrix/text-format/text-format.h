@@ -0,0 +1,130 @@
+#ifndef MATRIX_CALCULATOR_TEXT_FORMAT_H
+#define MATRIX_CALCULATOR_TEXT_FORMAT_H
+
+#include <charconv>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "../matrix.h"
+#include "../file-mapping/file-mapping.h"
+
+// text matrix format: size "n m" followed by n * m elements separated by whitespace, row by row.
+// Real elements are numbers, complex ones are "(re, im)" tuples, "(re)" and plain numbers are accepted as well
+
+// error of parsing text matrix, holds position where text can't be parsed
+class ParseError : public std::invalid_argument {
+private:
+    std::size_t line_;
+    std::size_t column_;
+
+public:
+    // return line and column of error, both are counted from 1
+    std::size_t line() const;
+    std::size_t column() const;
+
+    ParseError(const std::string &message, std::size_t line, std::size_t column);
+};
+
+// TextTuple<T>::value is true if elements of type T are written as tuples
+template<typename T>
+struct TextTuple : std::false_type {};
+
+template<typename T>
+struct TextTuple<std::complex<T>> : std::true_type {};
+
+// returns true if "symbol" separates elements
+bool is_text_space(char symbol);
+
+// returns pointer to the first character in [first, last) which isn't whitespace
+const char* skip_text_space(const char *first, const char *last);
+
+// parses decimal number with at most 19 digits whose value is exactly computed by one multiplication or division
+// by power of ten (like "-12.375" or "4.5e-3"), returns false for other numbers which need full std::from_chars
+template<typename T>
+bool parse_short_decimal(const char *first, const char *last, T &value, const char *&end);
+
+// parses element of type T at "first" without skipping whitespace, like std::from_chars.
+// Numbers may start with '+', complex elements are tuples or plain numbers
+template<typename T>
+std::from_chars_result parse_text_element(const char *first, const char *last, T &value);
+
+template<typename T>
+std::from_chars_result parse_text_element(const char *first, const char *last, std::complex<T> &value);
+
+// returns count of elements in [first, last) without parsing them
+template<typename T>
+std::size_t count_text_elements(const char *first, const char *last);
+
+// throws ParseError with position of "where" in "text"
+[[noreturn]] void throw_parse_error(std::string_view text, const char *where, const std::string &message);
+
+// parses "count" elements into "destination", starting from "first" and not going beyond "last",
+// returns pointer after the last element. "text" is the whole text, it's used for positions in errors
+template<typename T>
+const char* parse_text_elements(std::string_view text, const char *first, const char *last, T *destination, std::size_t count);
+
+// parses matrix from "text", which must contain nothing but the matrix.
+// Large texts are split by lines into parts which are parsed in parallel, if "parallel" is true.
+// Throws ParseError with position of the first malformed element
+template<typename T>
+Matrix<T> parse_text(std::string_view text, bool parallel = true);
+
+// reads matrix from text file through memory mapping
+template<typename T>
+Matrix<T> read_text(const std::string &path, bool parallel = true);
+
+// reads matrix from the rest of stream, which is read in large blocks
+template<typename T>
+Matrix<T> read_text(std::istream &istream, bool parallel = true);
+
+// input function, reads exactly one matrix and leaves the rest of stream, sets failbit if matrix is malformed
+template<typename T, typename Allocator>
+std::istream& operator>>(std::istream &istream, Matrix<T, Allocator> &matrix);
+
+// formatter of elements of type T. Floating-point numbers and their complex tuples are written by std::to_chars
+// when flags of stream allow it, the rest are written by string stream with the same flags.
+// Exact formatter writes floating-point numbers in the shortest form which is read back to the same number
+template<typename T>
+class TextFormatter {
+private:
+    std::optional<std::ostringstream> fallback; // stream for elements which std::to_chars can't write
+    std::chars_format format;
+    int precision;
+    bool exact;
+
+    // appends text of floating-point number to "text"
+    template<typename U>
+    void append_number(std::string &text, U value);
+
+public:
+    // appends text of "value" to "text"
+    void append(std::string &text, const T &value);
+
+    TextFormatter(const std::ostream &ostream, bool exact);
+};
+
+// output function, elements are aligned by columns. Every element is evaluated and formatted once,
+// rows are written into stream by large blocks
+template<typename T, typename E>
+std::ostream& operator<<(std::ostream &ostream, const MatrixExpression<T, E> &expression);
+
+// writes matrix in text format read by parse_text and operator>>, without alignment.
+// Floating-point elements are written exactly, rows are evaluated and written one by one,
+// so large matrices are never held as text
+template<typename T, typename E>
+void write_text(std::ostream &ostream, const MatrixExpression<T, E> &expression);
+
+template<typename T, typename E>
+void write_text(const std::string &path, const MatrixExpression<T, E> &expression);
+
+#include "text-format.tpp"
+
+#endif //MATRIX_CALCULATOR_TEXT_FORMAT_H
@@ -0,0 +1,537 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <cstring>
+#include <fstream>
+#include <locale>
+#include <vector>
+
+// ParseError implementation //
+
+inline std::size_t ParseError::line() const {
+    return line_;
+}
+
+inline std::size_t ParseError::column() const {
+    return column_;
+}
+
+inline ParseError::ParseError(const std::string &message, std::size_t line, std::size_t column) :
+std::invalid_argument("line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message),
+line_(line), column_(column) {}
+
+// parsing functions implementation //
+
+// size of text part parsed by one task, smaller texts are parsed by calling thread
+constexpr std::size_t TEXT_PART_BYTES = std::size_t(1) << 16;
+
+inline bool is_text_space(char symbol) {
+    // one test of bit mask instead of comparison with every whitespace character
+    constexpr std::uint64_t spaces = (std::uint64_t(1) << ' ') | (std::uint64_t(1) << '\n') | (std::uint64_t(1) << '\t') |
+                                     (std::uint64_t(1) << '\r') | (std::uint64_t(1) << '\v') | (std::uint64_t(1) << '\f');
+    unsigned code = static_cast<unsigned char>(symbol);
+    return code <= ' ' && ((spaces >> code) & 1) != 0;
+}
+
+inline const char* skip_text_space(const char *first, const char *last) {
+    while (first != last && is_text_space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+template<typename T>
+bool parse_short_decimal(const char *first, const char *last, T &value, const char *&end) {
+    // powers of ten which are exact in T, so product or quotient of exact mantissa and power is correctly rounded
+    constexpr int max_power = (std::numeric_limits<T>::digits >= 53 ? 22 : 10);
+    constexpr auto powers = [] {
+        std::array<T, max_power + 1> result{};
+        result[0] = 1;
+        for (int k = 1; k <= max_power; ++k) {
+            result[k] = result[k-1] * 10;
+        }
+        return result;
+    }();
+
+    const char *position = first;
+    bool negative = (position != last && *position == '-');
+    position += negative;
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; position != last && static_cast<unsigned>(*position - '0') < 10; ++position, ++digits) {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*position - '0');
+    }
+    if (position != last && *position == '.') {
+        for (++position; position != last && static_cast<unsigned>(*position - '0') < 10; ++position, ++digits) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*position - '0');
+            --exponent;
+        }
+    }
+    if (digits == 0 || digits > 19) {
+        return false;
+    }
+
+    if (position != last && (*position == 'e' || *position == 'E')) {
+        ++position;
+        bool negative_exponent = (position != last && *position == '-');
+        position += (position != last && (*position == '-' || *position == '+'));
+        int written = 0;
+        int exponent_digits = 0;
+        for (; position != last && static_cast<unsigned>(*position - '0') < 10 && exponent_digits < 4; ++position, ++exponent_digits) {
+            written = written * 10 + (*position - '0');
+        }
+        if (exponent_digits == 0 || (position != last && static_cast<unsigned>(*position - '0') < 10)) {
+            return false;
+        }
+        exponent += (negative_exponent ? -written : written);
+    }
+
+    if (mantissa > (std::uint64_t(1) << std::numeric_limits<T>::digits) || exponent < -max_power || exponent > max_power) {
+        return false;
+    }
+    T result = static_cast<T>(mantissa);
+    result = (exponent < 0 ? result / powers[-exponent] : result * powers[exponent]);
+    value = (negative ? -result : result);
+    end = position;
+    return true;
+}
+
+template<typename T>
+std::from_chars_result parse_text_element(const char *first, const char *last, T &value) {
+    // formatted input accepts explicit plus sign, std::from_chars doesn't
+    const char *start = first;
+    if (last - first > 1 && first[0] == '+' && first[1] != '-' && first[1] != '+') {
+        ++start;
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        const char *end;
+        if (parse_short_decimal(start, last, value, end)) {
+            return std::from_chars_result{end, std::errc()};
+        }
+    }
+    std::from_chars_result result = std::from_chars(start, last, value);
+    if (result.ec != std::errc()) {
+        result.ptr = first;
+    }
+    return result;
+}
+
+template<typename T>
+std::from_chars_result parse_text_element(const char *first, const char *last, std::complex<T> &value) {
+    T real = T();
+    T imag = T();
+    if (first == last || *first != '(') {
+        std::from_chars_result result = parse_text_element(first, last, real);
+        value = std::complex<T>(real, imag);
+        return result;
+    }
+
+    std::from_chars_result result = parse_text_element(skip_text_space(first + 1, last), last, real);
+    if (result.ec != std::errc()) {
+        return result;
+    }
+    const char *position = skip_text_space(result.ptr, last);
+    if (position != last && *position == ',') {
+        result = parse_text_element(skip_text_space(position + 1, last), last, imag);
+        if (result.ec != std::errc()) {
+            return result;
+        }
+        position = skip_text_space(result.ptr, last);
+    }
+    if (position == last || *position != ')') {
+        return std::from_chars_result{position, std::errc::invalid_argument};
+    }
+    value = std::complex<T>(real, imag);
+    return std::from_chars_result{position + 1, std::errc()};
+}
+
+template<typename T>
+std::size_t count_text_elements(const char *first, const char *last) {
+    // elements start after whitespace, whitespace inside complex tuples doesn't separate elements
+    constexpr bool tuples = TextTuple<T>::value;
+    std::size_t count = 0;
+    bool space = true;
+    bool inside = false;
+    for (const char *position = first; position != last; ++position) {
+        char symbol = *position;
+        if (inside) {
+            inside = (symbol != ')');
+        }
+        else if (is_text_space(symbol)) {
+            space = true;
+        }
+        else {
+            if (space) {
+                ++count;
+                inside = (tuples && symbol == '(');
+            }
+            space = false;
+        }
+    }
+    return count;
+}
+
+inline void throw_parse_error(std::string_view text, const char *where, const std::string &message) {
+    std::size_t offset = std::size_t(where - text.data());
+    std::size_t line = 1 + std::size_t(std::count(text.data(), where, '\n'));
+    std::size_t line_break = (offset == 0 ? std::string_view::npos : text.rfind('\n', offset - 1));
+    std::size_t column = offset - (line_break == std::string_view::npos ? 0 : line_break + 1) + 1;
+
+    // a few characters at error are quoted, so malformed element is easy to find
+    std::size_t length = 0;
+    while (offset + length < text.size() && length < 24 && !is_text_space(text[offset + length])) {
+        ++length;
+    }
+    if (length == 0) {
+        throw ParseError(message, line, column);
+    }
+    throw ParseError(message + " near \"" + std::string(text.substr(offset, length)) + "\"", line, column);
+}
+
+template<typename T>
+const char* parse_text_elements(std::string_view text, const char *first, const char *last, T *destination, std::size_t count) {
+    const char *position = first;
+    for (std::size_t k = 0; k < count; ++k) {
+        position = skip_text_space(position, last);
+        if (position == last) {
+            throw_parse_error(text, position, "text ends before all elements of matrix are read");
+        }
+        auto [next, error] = parse_text_element(position, last, destination[k]);
+        if (error == std::errc::result_out_of_range) {
+            throw_parse_error(text, next, "number is out of range");
+        }
+        if (error != std::errc()) {
+            throw_parse_error(text, next, "malformed element");
+        }
+        if (next != last && !is_text_space(*next)) {
+            throw_parse_error(text, next, "unexpected character after element");
+        }
+        position = next;
+    }
+    return position;
+}
+
+template<typename T>
+Matrix<T> parse_text(std::string_view text, bool parallel) {
+    const char *begin = text.data();
+    const char *end = text.data() + text.size();
+
+    std::size_t size[2];
+    const char *position = begin;
+    for (std::size_t &value : size) {
+        position = skip_text_space(position, end);
+        auto [next, error] = std::from_chars(position, end, value);
+        if (error != std::errc() || (next != end && !is_text_space(*next))) {
+            throw_parse_error(text, position, "size of matrix expected");
+        }
+        position = next;
+    }
+    // every element takes at least one character, so sizes of corrupted texts don't cause huge allocations
+    std::size_t n = size[0];
+    std::size_t m = size[1];
+    std::size_t bytes = std::size_t(end - position);
+    if (m != 0 && n > bytes / m) {
+        throw_parse_error(text, end, "text ends before all elements of matrix are read");
+    }
+    auto result = Matrix<T>(n, m);
+    std::size_t count = n * m;
+
+    std::size_t threads = (parallel ? thread_count() : 1);
+    std::size_t parts = (threads > 1 ? std::min(threads * 4, bytes / TEXT_PART_BYTES) : 1);
+    if (parts > 1) {
+        // bounds of parts are moved to line breaks, so they fall between elements
+        std::vector<const char*> bounds = std::vector<const char*>(parts + 1);
+        bounds[0] = position;
+        bounds[parts] = end;
+        for (std::size_t k = 1; k < parts; ++k) {
+            const char *bound = std::max(position + bytes * k / parts, bounds[k-1]);
+            const char *line_break = static_cast<const char*>(std::memchr(bound, '\n', std::size_t(end - bound)));
+            bounds[k] = (line_break != nullptr ? line_break : end);
+        }
+
+        // elements are counted first, so every part knows where its elements go
+        std::vector<std::size_t> offsets = std::vector<std::size_t>(parts + 1);
+        parallel_for(parts, bytes, [&](std::size_t k) {
+            offsets[k+1] = count_text_elements<T>(bounds[k], bounds[k+1]);
+        });
+        for (std::size_t k = 0; k < parts; ++k) {
+            offsets[k+1] += offsets[k];
+        }
+
+        if (offsets[parts] == count) {
+            try {
+                parallel_for(parts, bytes, [&](std::size_t k) {
+                    std::size_t elements = offsets[k+1] - offsets[k];
+                    const char *rest = parse_text_elements(text, bounds[k], bounds[k+1], result.data() + offsets[k], elements);
+                    if (skip_text_space(rest, bounds[k+1]) != bounds[k+1]) {
+                        throw_parse_error(text, skip_text_space(rest, bounds[k+1]), "unexpected character after element");
+                    }
+                });
+                return result;
+            }
+            catch (const ParseError &) {}
+        }
+        // text is malformed, or element is split between lines: it's parsed serially, which finds the first error
+    }
+
+    position = parse_text_elements(text, position, end, result.data(), count);
+    position = skip_text_space(position, end);
+    if (position != end) {
+        throw_parse_error(text, position, "unexpected text after the last element of matrix");
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> read_text(const std::string &path, bool parallel) {
+    FileMapping mapping = FileMapping(path, MapMode::read_only);
+    return parse_text<T>(std::string_view(static_cast<const char*>(mapping.data()), mapping.size()), parallel);
+}
+
+template<typename T>
+Matrix<T> read_text(std::istream &istream, bool parallel) {
+    constexpr std::size_t block = std::size_t(1) << 20;
+    std::string text;
+    std::size_t size = 0;
+    while (istream) {
+        text.resize(size + block);
+        istream.read(text.data() + size, std::streamsize(block));
+        size += std::size_t(istream.gcount());
+    }
+    text.resize(size);
+    // the whole stream is read, this isn't a failure
+    istream.clear(std::ios::eofbit);
+    return parse_text<T>(text, parallel);
+}
+
+// input function //
+
+template<typename T, typename Allocator>
+std::istream& operator>>(std::istream &istream, Matrix<T, Allocator> &matrix) {
+    std::size_t n, m;
+    if (!(istream >> n >> m)) {
+        return istream;
+    }
+    matrix.resize(n, m);
+
+    // elements are taken from stream buffer directly, without sentries and locale of formatted input
+    constexpr bool tuples = TextTuple<T>::value;
+    std::streambuf &buffer = *istream.rdbuf();
+    constexpr int end = std::char_traits<char>::eof();
+    // token keeps its capacity between elements, so long tokens are read whole without allocation per element
+    std::string token;
+    for (std::size_t k = 0; k < n * m; ++k) {
+        int symbol = buffer.sgetc();
+        while (symbol != end && is_text_space(char(symbol))) {
+            symbol = buffer.snextc();
+        }
+
+        // token lasts up to whitespace, complex tuple lasts up to closing parenthesis
+        bool tuple = (tuples && symbol == '(');
+        token.clear();
+        while (symbol != end && (tuple || !is_text_space(char(symbol)))) {
+            token.push_back(char(symbol));
+            symbol = buffer.snextc();
+            if (tuple && token.back() == ')') {
+                break;
+            }
+        }
+
+        const char *first = token.data();
+        const char *last = first + token.size();
+        auto [next, error] = parse_text_element(first, last, matrix.data()[k]);
+        if (error != std::errc() || next != last) {
+            istream.setstate(symbol == end ? std::ios::failbit | std::ios::eofbit : std::ios::failbit);
+            return istream;
+        }
+        if (symbol == end) {
+            istream.setstate(std::ios::eofbit);
+        }
+    }
+    return istream;
+}
+
+// TextFormatter implementation //
+
+template<typename T>
+template<typename U>
+void TextFormatter<T>::append_number(std::string &text, U value) {
+    char buffer[64];
+    std::to_chars_result result = (exact ? std::to_chars(buffer, buffer + sizeof(buffer), value) :
+                                           std::to_chars(buffer, buffer + sizeof(buffer), value, format, precision));
+    if (result.ec == std::errc()) {
+        text.append(buffer, result.ptr);
+        return;
+    }
+
+    // fixed format of large numbers or large precision needs longer buffer
+    std::size_t size = text.size();
+    for (std::size_t capacity = 2 * sizeof(buffer); ; capacity *= 2) {
+        text.resize(size + capacity);
+        result = std::to_chars(text.data() + size, text.data() + text.size(), value, format, precision);
+        if (result.ec == std::errc()) {
+            text.resize(std::size_t(result.ptr - text.data()));
+            return;
+        }
+    }
+}
+
+template<typename T>
+void TextFormatter<T>::append(std::string &text, const T &value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (!fallback) {
+            append_number(text, value);
+            return;
+        }
+    }
+    else if constexpr (TextTuple<T>::value) {
+        if (!fallback) {
+            // the same tuple as operator<< of std::complex writes, exact tuples are the ones of text matrix files
+            text += '(';
+            append_number(text, value.real());
+            text += (exact ? ", " : ",");
+            append_number(text, value.imag());
+            text += ')';
+            return;
+        }
+    }
+    fallback->str(std::string());
+    *fallback << value;
+    text += fallback->view();
+}
+
+template<typename T>
+TextFormatter<T>::TextFormatter(const std::ostream &ostream, bool exact_) :
+format(std::chars_format::general), precision(int(ostream.precision())), exact(exact_) {
+    std::ios_base::fmtflags flags = ostream.flags();
+    std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+    if (floatfield == std::ios_base::fixed) {
+        format = std::chars_format::fixed;
+    }
+    else if (floatfield == std::ios_base::scientific) {
+        format = std::chars_format::scientific;
+    }
+
+    // std::to_chars writes numbers like stream with default flags and classic locale, other flags need stream
+    bool plain = (flags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase)) == 0 &&
+                 floatfield != (std::ios_base::fixed | std::ios_base::scientific) &&
+                 ostream.getloc() == std::locale::classic();
+    if (!(std::is_floating_point_v<T> || TextTuple<T>::value) || !(plain || exact)) {
+        fallback.emplace();
+        if (exact) {
+            fallback->imbue(std::locale::classic());
+        }
+        else {
+            fallback->copyfmt(ostream);
+            fallback->width(0);
+        }
+    }
+}
+
+// output functions implementation //
+
+// size of text which is collected before it's written into stream
+constexpr std::size_t TEXT_BLOCK_BYTES = std::size_t(1) << 16;
+
+template<typename T, typename E>
+std::ostream& operator<<(std::ostream &ostream, const MatrixExpression<T, E> &expression) {
+    if constexpr (!E::has_storage) {
+        // lazy expression is evaluated by blocked kernels instead of element by element
+        return ostream << Matrix<T>(expression);
+    }
+    else {
+        const E &matrix = static_cast<const E&>(expression);
+        std::size_t n = matrix.n();
+        std::size_t m = matrix.m();
+        TextFormatter<T> formatter = TextFormatter<T>(ostream, false);
+        ostream.width(0);
+        if (n == 0) {
+            return ostream;
+        }
+
+        // texts of all elements are kept, since widths of columns are known only after the last row
+        std::string texts;
+        std::vector<std::size_t> ends = std::vector<std::size_t>(n * m);
+        std::vector<std::size_t> widths = std::vector<std::size_t>(m);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                std::size_t start = texts.size();
+                formatter.append(texts, matrix[i, j]);
+                ends[i * m + j] = texts.size();
+                widths[j] = std::max(widths[j], texts.size() - start);
+            }
+        }
+
+        // columns are separated by at least three fill characters, rows don't end with line break
+        std::string block;
+        block.reserve(TEXT_BLOCK_BYTES);
+        char fill = ostream.fill();
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i > 0) {
+                block += '\n';
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                std::size_t end = ends[i * m + j];
+                block.append(texts, start, end - start);
+                block.append(widths[j] + 3 - (end - start), fill);
+                start = end;
+            }
+            if (block.size() >= TEXT_BLOCK_BYTES) {
+                ostream.write(block.data(), std::streamsize(block.size()));
+                block.clear();
+            }
+        }
+        ostream.write(block.data(), std::streamsize(block.size()));
+        return ostream;
+    }
+}
+
+template<typename T, typename E>
+void write_text(std::ostream &ostream, const MatrixExpression<T, E> &expression) {
+    if constexpr (!E::has_storage) {
+        write_text(ostream, Matrix<T>(expression));
+    }
+    else {
+        const E &matrix = static_cast<const E&>(expression);
+        std::size_t n = matrix.n();
+        std::size_t m = matrix.m();
+        TextFormatter<T> formatter = TextFormatter<T>(ostream, true);
+
+        std::string block = std::to_string(n) + ' ' + std::to_string(m) + '\n';
+        block.reserve(TEXT_BLOCK_BYTES);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                if (j > 0) {
+                    block += ' ';
+                }
+                formatter.append(block, matrix[i, j]);
+            }
+            block += '\n';
+            if (block.size() >= TEXT_BLOCK_BYTES) {
+                ostream.write(block.data(), std::streamsize(block.size()));
+                block.clear();
+            }
+        }
+        ostream.write(block.data(), std::streamsize(block.size()));
+
+        if (!ostream) {
+            throw std::runtime_error("text matrix can't be written");
+        }
+    }
+}
+
+template<typename T, typename E>
+void write_text(const std::string &path, const MatrixExpression<T, E> &expression) {
+    std::ofstream ostream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!ostream) {
+        throw std::runtime_error("file " + path + " can't be opened");
+    }
+    write_text(ostream, expression);
+    ostream.close();
+    if (!ostream) {
+        throw std::runtime_error("text matrix can't be written");
+    }
+}
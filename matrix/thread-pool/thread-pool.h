@@ -0,0 +1,94 @@
+#ifndef MATRIX_CALCULATOR_THREAD_POOL_H
+#define MATRIX_CALCULATOR_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// environment variable with count of threads used by library, count of processors is used if it isn't set
+constexpr const char *THREADS_VARIABLE = "MATRIX_NUM_THREADS";
+
+// work of fewer operations than PARALLEL_THRESHOLD is done by calling thread only
+constexpr std::size_t PARALLEL_THRESHOLD = std::size_t(1) << 18;
+
+// pool of threads shared by the whole library. Calling thread takes part in work, so pool of size 1 has no workers
+class ThreadPool {
+private:
+    // tasks of one parallel_for call, indices are taken by threads one by one
+    struct Job {
+        const void *task;
+        void (*call)(const void *task, std::size_t index);
+        std::size_t count;
+        std::atomic<std::size_t> next;
+        std::size_t pending;
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> worker_count; // size of "workers", read without locks
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    Job *current;
+    std::uint64_t generation;
+    bool stopping;
+
+    // only one parallel_for is run by pool at a time
+    std::mutex job_mutex;
+
+    // runs tasks of "job" until there are no indices left
+    void work(Job &job);
+
+    // loop of worker thread, jobs of generations after "seen" are run
+    void worker_loop(std::uint64_t seen);
+
+    // gives "job" to workers, takes part in it and waits for workers to finish
+    void run(Job &job);
+
+    void start(std::size_t size);
+    void stop();
+
+public:
+    // returns pool of library, sized from THREADS_VARIABLE or count of processors
+    static ThreadPool& global();
+
+    // returns true if calling thread executes task of some pool
+    static bool inside_task();
+
+    // returns count of threads including calling one
+    std::size_t size() const;
+
+    // changes count of threads including calling one, waits for running work to finish
+    void resize(std::size_t size);
+
+    // calls task(index) for every index in 0..count-1 and returns when all calls are finished.
+    // If called from a task or while pool is busy with another caller, tasks are run by calling thread one by one.
+    // Exception thrown by a task is rethrown to the caller
+    template<typename F>
+    void parallel_for(std::size_t count, const F &task);
+
+    explicit ThreadPool(std::size_t size);
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool& operator=(const ThreadPool &other) = delete;
+    ~ThreadPool();
+};
+
+// return and set count of threads used by library, 1 forces serial execution
+std::size_t thread_count();
+void set_thread_count(std::size_t count);
+
+// calls task(index) for every index in 0..count-1, in parallel if "work" operations are worth it
+template<typename F>
+void parallel_for(std::size_t count, std::size_t work, const F &task);
+
+// splits rows 0..n-1 into blocks and calls task(begin, end) for every block, in parallel if "work" operations are worth it
+template<typename F>
+void parallel_rows(std::size_t n, std::size_t work, const F &task);
+
+#include "thread-pool.tpp"
+
+#endif //MATRIX_CALCULATOR_THREAD_POOL_H
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+// ThreadPool implementation //
+
+// true in worker threads and in calling thread while it runs tasks
+inline bool& inside_task_flag() {
+    thread_local bool flag = false;
+    return flag;
+}
+
+inline void ThreadPool::work(Job &job) {
+    bool &inside = inside_task_flag();
+    bool was_inside = inside;
+    inside = true;
+    for (std::size_t index = job.next++; index < job.count; index = job.next++) {
+        try {
+            job.call(job.task, index);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+    }
+    inside = was_inside;
+}
+
+inline void ThreadPool::worker_loop(std::uint64_t seen) {
+    inside_task_flag() = true;
+    while (true) {
+        Job *job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            job = current;
+        }
+
+        work(*job);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--job->pending == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+inline void ThreadPool::run(Job &job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &job;
+        job.pending = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    work(job);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return job.pending == 0; });
+        current = nullptr;
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+inline void ThreadPool::start(std::size_t size) {
+    stopping = false;
+    for (std::size_t k = 1; k < size; ++k) {
+        workers.emplace_back([this, seen = generation] { worker_loop(seen); });
+    }
+    worker_count = workers.size();
+}
+
+inline void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    worker_count = 0;
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+inline ThreadPool& ThreadPool::global() {
+    static ThreadPool pool([] {
+        const char *variable = std::getenv(THREADS_VARIABLE);
+        std::size_t size = (variable != nullptr ? std::strtoul(variable, nullptr, 10) : std::thread::hardware_concurrency());
+        return std::max<std::size_t>(size, 1);
+    }());
+    return pool;
+}
+
+inline bool ThreadPool::inside_task() {
+    return inside_task_flag();
+}
+
+inline std::size_t ThreadPool::size() const {
+    return worker_count + 1;
+}
+
+inline void ThreadPool::resize(std::size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("pool should have at least one thread");
+    }
+    std::lock_guard<std::mutex> lock(job_mutex);
+    stop();
+    start(size);
+}
+
+template<typename F>
+void ThreadPool::parallel_for(std::size_t count, const F &task) {
+    // workers are changed only under job_mutex, so they are checked once more after it is taken
+    std::unique_lock<std::mutex> busy(job_mutex, std::defer_lock);
+    if (worker_count == 0 || count < 2 || inside_task() || !busy.try_lock() || workers.empty()) {
+        for (std::size_t index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
+    }
+
+    Job job;
+    job.task = &task;
+    job.call = [](const void *task, std::size_t index) { (*static_cast<const F*>(task))(index); };
+    job.count = count;
+    job.next = 0;
+    run(job);
+}
+
+inline ThreadPool::ThreadPool(std::size_t size) : worker_count(0), current(nullptr), generation(0), stopping(false) {
+    start(std::max<std::size_t>(size, 1));
+}
+
+inline ThreadPool::~ThreadPool() {
+    stop();
+}
+
+// thread count functions implementation //
+
+inline std::size_t thread_count() {
+    return ThreadPool::global().size();
+}
+
+inline void set_thread_count(std::size_t count) {
+    ThreadPool::global().resize(count);
+}
+
+// parallel loops implementation //
+
+template<typename F>
+void parallel_for(std::size_t count, std::size_t work, const F &task) {
+    if (work < PARALLEL_THRESHOLD) {
+        for (std::size_t index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
+    }
+    ThreadPool::global().parallel_for(count, task);
+}
+
+template<typename F>
+void parallel_rows(std::size_t n, std::size_t work, const F &task) {
+    std::size_t threads = thread_count();
+    if (threads == 1 || work < PARALLEL_THRESHOLD || n < 2) {
+        task(std::size_t(0), n);
+        return;
+    }
+
+    // several blocks per thread even out uneven speed of threads, block bounds depend only on "n" and pool size
+    std::size_t blocks = std::min(n, threads * 4);
+    ThreadPool::global().parallel_for(blocks, [&](std::size_t block) {
+        task(n * block / blocks, n * (block + 1) / blocks);
+    });
+}
@@ -3,10 +3,11 @@
 
 #include<cmath>
 #include "../matrix/matrix.h"
+#include "../matrix/fixed-matrix/fixed-matrix.h"
 
 // returns matrix which rotates vector of size 2 by an "angle"
 template<typename T>
-Matrix<T> rotation_matrix(T angle);
+FixedMatrix<T, 2, 2> rotation_matrix(T angle);
 
 // returns matrix which projects vector on the line directed by "direction" vector
 template<typename T>
@@ -3,13 +3,9 @@
 #include "../eigenpairs-finder/eigenpairs-finder.h"
 
 template<typename T>
-Matrix<T> rotation_matrix(T angle) {
-    auto result = Matrix<T>(2);
-    result[0,0] = std::cos(angle);
-    result[0,1] = -std::sin(angle);
-    result[1,0] = std::sin(angle);
-    result[1,1] = std::cos(angle);
-    return result;
+FixedMatrix<T, 2, 2> rotation_matrix(T angle) {
+    return FixedMatrix<T, 2, 2>{std::cos(angle), -std::sin(angle),
+                                std::sin(angle), std::cos(angle)};
 }
 
 template<typename T>